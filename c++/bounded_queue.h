@@ -0,0 +1,118 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include "thread_pool.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// Ограниченная очередь без блокировок для нескольких производителей и
+// потребителей (кольцевой буфер Вьюкова). Каждая ячейка хранит номер хода:
+// производитель ждет seq == pos, потребитель - seq == pos + 1, так что
+// ячейку захватывает один CAS по голове или хвосту.
+//
+// try_push/try_pop не ждут. push/pop ждут с нарастающей паузой (сначала
+// вращение, затем уступка процессора): полная очередь притормаживает
+// производителя - это и есть обратное давление. После close() pop
+// возвращает false, когда очередь опустеет.
+template <typename T>
+class BoundedQueue {
+public:
+    // capacity округляется вверх до степени двойки
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    bool try_push(T& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // очередь заполнена
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& value) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // очередь пуста
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void push(T value) {
+        for (int attempt = 0; !try_push(value); ++attempt) {
+            pause(attempt);
+        }
+    }
+
+    // false - очередь закрыта и пуста
+    bool pop(T& value) {
+        for (int attempt = 0;; ++attempt) {
+            if (try_pop(value)) return true;
+            if (closed_.load(std::memory_order_acquire)) {
+                // Элементы, вставленные до close(), уже видны
+                return try_pop(value);
+            }
+            pause(attempt);
+        }
+    }
+
+    void close() { closed_.store(true, std::memory_order_release); }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    static void pause(int attempt) {
+        if (attempt < 64) return;
+        std::this_thread::yield();
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    alignas(kCacheLineSize) std::atomic<bool> closed_{false};
+};
+
+#endif // BOUNDED_QUEUE_H
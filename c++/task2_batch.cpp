@@ -0,0 +1,231 @@
+#include "task2_batch.h"
+#include "benchmark_utils.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace task2 {
+
+QueryResult answer_from_cells(const AgeHistogram& cells, int age_range) {
+    QueryResult result;
+    double age_sum = 0.0;
+    for (const auto& [age, cell] : cells) {
+        result.count += cell.count;
+        age_sum += static_cast<double>(age) * cell.count;
+    }
+    if (result.count == 0) return result;
+
+    result.average_age = age_sum / result.count;
+    for (const auto& [age, cell] : cells) {
+        if (std::abs(age - result.average_age) <= age_range && cell.max_salary > result.max_salary) {
+            result.max_salary = cell.max_salary;
+        }
+    }
+    return result;
+}
+
+void DenseAgeHistogram::merge(const DenseAgeHistogram& other) {
+    if (!other.cells.empty()) {
+        if (cells.empty()) cells.assign(kHistogramAges, AgeCell{});
+        for (int age = 0; age < kHistogramAges; ++age) cells[age].merge(other.cells[age]);
+    }
+    for (const auto& [age, cell] : other.overflow) overflow[age].merge(cell);
+}
+
+AgeHistogram DenseAgeHistogram::to_map() const {
+    AgeHistogram result = overflow;
+    for (size_t age = 0; age < cells.size(); ++age) {
+        if (cells[age].count > 0) result[static_cast<int>(age)].merge(cells[age]);
+    }
+    return result;
+}
+
+namespace {
+
+// Аккумулятор исполнителя: плотная матрица должность x возраст
+struct PositionAgeHistogram {
+    size_t num_positions = 0;
+    std::vector<AgeCell> cells;
+    std::map<std::pair<int, int>, AgeCell> overflow;
+
+    void reset(size_t positions) {
+        num_positions = positions;
+        cells.assign(positions * kHistogramAges, AgeCell{});
+    }
+
+    void add(int position_id, int age, double salary) {
+        if (age >= 0 && age < kHistogramAges) {
+            cells[position_id * kHistogramAges + age].add(salary);
+        } else {
+            overflow[{position_id, age}].add(salary);
+        }
+    }
+
+    void merge(const PositionAgeHistogram& other) {
+        if (other.cells.empty()) return;
+        if (cells.empty()) {
+            *this = other;
+            return;
+        }
+        for (size_t i = 0; i < cells.size(); ++i) {
+            cells[i].merge(other.cells[i]);
+        }
+        for (const auto& [key, cell] : other.overflow) {
+            overflow[key].merge(cell);
+        }
+    }
+};
+
+} // namespace
+
+BatchResult compute_all_positions(const EmployeeTable& table, int num_threads, int age_range) {
+    const auto& rows = table.rows();
+    const auto& ids = table.position_ids();
+    size_t num_positions = table.positions().size();
+
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+    PositionAgeHistogram histogram = pool.parallel_reduce<PositionAgeHistogram>(
+        0, rows.size(),
+        [&](size_t begin, size_t end, PositionAgeHistogram& acc) {
+            if (acc.cells.empty()) acc.reset(num_positions);
+            for (size_t j = begin; j < end; ++j) {
+                acc.add(ids[j], rows[j].age, rows[j].salary);
+            }
+        });
+
+    BatchResult results;
+    if (histogram.cells.empty()) return results;
+
+    std::vector<AgeHistogram> per_position(num_positions);
+    for (size_t p = 0; p < num_positions; ++p) {
+        for (int age = 0; age < kHistogramAges; ++age) {
+            const AgeCell& cell = histogram.cells[p * kHistogramAges + age];
+            if (cell.count > 0) per_position[p][age] = cell;
+        }
+    }
+    for (const auto& [key, cell] : histogram.overflow) {
+        per_position[key.first][key.second].merge(cell);
+    }
+
+    for (size_t p = 0; p < num_positions; ++p) {
+        results[table.positions()[p]] = answer_from_cells(per_position[p], age_range);
+    }
+    return results;
+}
+
+BatchResult compute_all_positions_hash(const std::vector<Employee>& employees, int age_range) {
+    std::unordered_map<std::string, std::unordered_map<int, AgeCell>> groups;
+    for (const auto& emp : employees) {
+        groups[emp.position][emp.age].add(emp.salary);
+    }
+
+    BatchResult results;
+    for (const auto& [position, by_age] : groups) {
+        AgeHistogram cells(by_age.begin(), by_age.end());
+        results[position] = answer_from_cells(cells, age_range);
+    }
+    return results;
+}
+
+BatchResult compute_all_positions_sort(const std::vector<Employee>& employees, int age_range) {
+    std::vector<size_t> order(employees.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (employees[a].position != employees[b].position) {
+            return employees[a].position < employees[b].position;
+        }
+        return employees[a].age < employees[b].age;
+    });
+
+    BatchResult results;
+    size_t i = 0;
+    while (i < order.size()) {
+        const std::string& position = employees[order[i]].position;
+        AgeHistogram cells;
+        auto hint = cells.end();
+
+        // Группа одной должности; внутри нее строки уже упорядочены по возрасту
+        for (; i < order.size() && employees[order[i]].position == position; ++i) {
+            const auto& emp = employees[order[i]];
+            if (hint == cells.end() || hint->first != emp.age) {
+                hint = cells.emplace_hint(cells.end(), emp.age, AgeCell{});
+            }
+            hint->second.add(emp.salary);
+        }
+
+        results[position] = answer_from_cells(cells, age_range);
+    }
+    return results;
+}
+
+void run_batch_benchmark() {
+    std::cout << "\n=== Бенчмарк пакетного запроса по всем должностям ===\n";
+
+    std::string target_position = "Инженер";
+    std::vector<int> test_sizes = {100000, 1000000};
+    const int num_threads = 4;
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    for (int size : test_sizes) {
+        auto employees = generate_employees(size, target_position);
+        EmployeeTable table(employees);
+
+        BatchResult loop_result, histogram_result, hash_result, sort_result;
+        double loop_time, histogram_time, hash_time, sort_time;
+
+        {
+            Benchmark b("Цикл по должностям", false);
+            for (const auto& position : table.positions()) {
+                loop_result[position] = compute_multi_thread(employees, position, num_threads);
+            }
+            loop_time = b.elapsed_microseconds();
+        }
+
+        {
+            Benchmark b("Гистограммы", false);
+            histogram_result = compute_all_positions(table, num_threads);
+            histogram_time = b.elapsed_microseconds();
+        }
+
+        {
+            Benchmark b("Хеш-группировка", false);
+            hash_result = compute_all_positions_hash(employees);
+            hash_time = b.elapsed_microseconds();
+        }
+
+        {
+            Benchmark b("Сортировка", false);
+            sort_result = compute_all_positions_sort(employees);
+            sort_time = b.elapsed_microseconds();
+        }
+
+        for (const auto* other : {&histogram_result, &hash_result, &sort_result}) {
+            for (const auto& [position, expected] : loop_result) {
+                const QueryResult& actual = other->at(position);
+                if (actual.count != expected.count || actual.max_salary != expected.max_salary) {
+                    std::cerr << "Ошибка: пакетный результат для '" << position
+                              << "' не совпадает с одиночным запросом\n";
+                }
+            }
+        }
+
+        std::string prefix = std::to_string(size) + "_сотр_";
+        std::vector<std::pair<std::string, double>> size_results = {
+            {prefix + "цикл_" + std::to_string(table.positions().size()) + "_запросов", loop_time},
+            {prefix + "гистограммы_" + std::to_string(num_threads) + "п", histogram_time},
+            {prefix + "хеш", hash_time},
+            {prefix + "сортировка", sort_time}
+        };
+
+        Benchmark::print_results(size_results, "Все должности, " + std::to_string(size) + " сотрудников");
+        benchmark_results.insert(benchmark_results.end(), size_results.begin(), size_results.end());
+    }
+
+    Benchmark::save_to_csv(benchmark_results, "batch_benchmark.csv");
+}
+
+} // namespace task2
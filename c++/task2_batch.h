@@ -0,0 +1,74 @@
+#ifndef TASK2_BATCH_H
+#define TASK2_BATCH_H
+
+#include "task2_table.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace task2 {
+
+// Возрасты вне [0, kHistogramAges) уходят в отдельную таблицу переполнения
+constexpr int kHistogramAges = 128;
+
+// Ячейка гистограммы: число строк и максимальная зарплата
+struct AgeCell {
+    int count = 0;
+    double max_salary = 0.0;
+
+    void add(double salary) {
+        count++;
+        if (salary > max_salary) max_salary = salary;
+    }
+
+    void merge(const AgeCell& other) {
+        count += other.count;
+        if (other.max_salary > max_salary) max_salary = other.max_salary;
+    }
+};
+
+// Гистограмма одной должности: возраст -> ячейка
+using AgeHistogram = std::map<int, AgeCell>;
+
+// Ответ для одной должности по ее гистограмме
+QueryResult answer_from_cells(const AgeHistogram& cells, int age_range);
+
+// Гистограмма одной должности для потоковых проходов: плотный массив по
+// возрастам [0, kHistogramAges) и таблица переполнения для остальных.
+// Годится как аккумулятор parallel_reduce
+struct DenseAgeHistogram {
+    std::vector<AgeCell> cells;
+    AgeHistogram overflow;
+
+    void add(int age, double salary) {
+        if (cells.empty()) cells.assign(kHistogramAges, AgeCell{});
+        if (age >= 0 && age < kHistogramAges) {
+            cells[age].add(salary);
+        } else {
+            overflow[age].add(salary);
+        }
+    }
+
+    void merge(const DenseAgeHistogram& other);
+    AgeHistogram to_map() const;
+};
+
+// Ответы варианта 26 для всех должностей сразу
+using BatchResult = std::map<std::string, QueryResult>;
+
+// Один параллельный проход с гистограммами "должность x возраст" у каждого
+// исполнителя: количество и максимальная зарплата в каждой ячейке.
+BatchResult compute_all_positions(const EmployeeTable& table, int num_threads, int age_range = 2);
+
+// Группировка через хеш-таблицу (должность -> возраст -> ячейка)
+BatchResult compute_all_positions_hash(const std::vector<Employee>& employees, int age_range = 2);
+
+// Группировка через сортировку по (должность, возраст)
+BatchResult compute_all_positions_sort(const std::vector<Employee>& employees, int age_range = 2);
+
+// Бенчмарк: пакетный запрос против цикла запросов по одной должности
+void run_batch_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_BATCH_H
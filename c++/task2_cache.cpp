@@ -0,0 +1,175 @@
+#include "task2_cache.h"
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace task2 {
+
+QueryCache::QueryCache(size_t capacity)
+    : capacity_(capacity < 1 ? 1 : capacity) {}
+
+QueryResult QueryCache::get_or_compute(const EmployeeTable& table,
+                                       const std::string& target_position,
+                                       int age_range) {
+    Key key{table.id(), target_position, age_range};
+    uint64_t version = table.version();
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            if (it->second->version == version) {
+                hits_++;
+                lru_.splice(lru_.begin(), lru_, it->second);
+                return it->second->result;
+            }
+
+            // Таблица изменилась после вычисления записи
+            invalidations_++;
+            lru_.erase(it->second);
+            entries_.erase(it);
+        }
+        misses_++;
+    }
+
+    // Вычисляем без блокировки, чтобы не задерживать другие запросы
+    QueryResult result = compute_indexed(table, target_position, age_range);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        // Пока мы считали, ту же запись мог добавить другой поток. Более
+        // медленное вычисление по старой версии не должно ее откатить
+        if (version > it->second->version) {
+            it->second->version = version;
+            it->second->result = result;
+        }
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return result;
+    }
+
+    lru_.push_front(Entry{key, version, result});
+    entries_[key] = lru_.begin();
+
+    if (lru_.size() > capacity_) {
+        entries_.erase(lru_.back().key);
+        lru_.pop_back();
+        evictions_++;
+    }
+
+    return result;
+}
+
+void QueryCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    lru_.clear();
+    entries_.clear();
+}
+
+size_t QueryCache::size() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return lru_.size();
+}
+
+double QueryCache::hit_ratio() const {
+    uint64_t hits = hits_.load();
+    uint64_t total = hits + misses_.load();
+    return total > 0 ? static_cast<double>(hits) / total : 0.0;
+}
+
+void run_cache_benchmark() {
+    std::cout << "\n=== Бенчмарк кэша результатов запросов ===\n";
+
+    std::string target_position = "Инженер";
+    const int table_size = 100000;
+    const int num_queries = 20000;
+    const int write_every = 2000;
+    const size_t cache_capacity = 32;
+
+    auto employees = generate_employees(table_size, target_position);
+    auto updates = generate_employees(num_queries / write_every + 1, target_position);
+    EmployeeTable cached_table(employees);
+    EmployeeTable plain_table(employees);
+
+    // Все пары (должность, age_range) упорядочены по популярности (Ципф, s = 1.1)
+    std::vector<std::pair<std::string, int>> keys;
+    for (const auto& position : cached_table.positions()) {
+        for (int range = 0; range <= 10; ++range) {
+            keys.emplace_back(position, range);
+        }
+    }
+
+    std::vector<double> weights(keys.size());
+    for (size_t k = 0; k < keys.size(); ++k) {
+        weights[k] = 1.0 / std::pow(static_cast<double>(k + 1), 1.1);
+    }
+
+    std::mt19937 gen(26);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    std::discrete_distribution<size_t> key_dist(weights.begin(), weights.end());
+
+    std::vector<size_t> trace(num_queries);
+    for (auto& k : trace) {
+        k = key_dist(gen);
+    }
+
+    // Каждый запрос замеряется отдельно, чтобы обновления таблицы не
+    // попадали в замер; попадание в кэш - около 100 нс, поэтому суммы в нс
+    using Clock = std::chrono::steady_clock;
+    QueryCache cache(cache_capacity);
+    std::chrono::nanoseconds plain_ns{0}, cached_ns{0};
+    int mismatches = 0;
+
+    for (int q = 0; q < num_queries; ++q) {
+        // Редкие изменения таблицы
+        if (q > 0 && q % write_every == 0) {
+            const Employee& emp = updates[q / write_every];
+            size_t row = gen() % table_size;
+            cached_table.update(row, emp);
+            plain_table.update(row, emp);
+        }
+
+        const auto& key = keys[trace[q]];
+        QueryResult plain, cached;
+
+        auto start = Clock::now();
+        plain = compute_indexed(plain_table, key.first, key.second);
+        auto middle = Clock::now();
+        cached = cache.get_or_compute(cached_table, key.first, key.second);
+        plain_ns += middle - start;
+        cached_ns += Clock::now() - middle;
+
+        if (plain.count != cached.count || plain.max_salary != cached.max_salary) {
+            mismatches++;
+        }
+    }
+
+    double plain_time = plain_ns.count() / 1000.0;
+    double cached_time = cached_ns.count() / 1000.0;
+
+    if (mismatches > 0) {
+        std::cerr << "Ошибка: " << mismatches << " ответов кэша не совпали с пересчетом\n";
+    }
+
+    std::cout << "Запросов: " << num_queries << ", различных ключей: " << keys.size()
+              << ", емкость кэша: " << cache.capacity() << "\n";
+    std::cout << "Попаданий: " << cache.hits() << ", промахов: " << cache.misses()
+              << " (из них устаревших: " << cache.invalidations() << ")"
+              << ", вытеснений: " << cache.evictions() << "\n";
+    std::cout << "Доля попаданий: " << std::fixed << std::setprecision(1)
+              << cache.hit_ratio() * 100 << "%\n";
+
+    std::vector<std::pair<std::string, double>> benchmark_results = {
+        {"Без_кэша", plain_time},
+        {"С_кэшем", cached_time}
+    };
+
+    Benchmark::print_comparison("Без кэша", plain_time, "С кэшем", cached_time);
+    Benchmark::save_to_csv(benchmark_results, "cache_benchmark.csv");
+}
+
+} // namespace task2
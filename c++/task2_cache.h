@@ -0,0 +1,80 @@
+#ifndef TASK2_CACHE_H
+#define TASK2_CACHE_H
+
+#include "task2_table.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace task2 {
+
+// Кэш результатов запросов (таблица, должность, age_range) перед функциями
+// task2. Каждая запись помнит версию таблицы, при которой была вычислена:
+// после изменения таблицы запись считается устаревшей и пересчитывается.
+// Таблица входит в ключ по EmployeeTable::id(), так что один кэш можно
+// использовать с несколькими таблицами.
+// При переполнении вытесняется давно не использованная запись (LRU).
+class QueryCache {
+public:
+    explicit QueryCache(size_t capacity = 64);
+
+    QueryResult get_or_compute(const EmployeeTable& table,
+                               const std::string& target_position,
+                               int age_range = 2);
+
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+    uint64_t hits() const { return hits_.load(); }
+    uint64_t misses() const { return misses_.load(); }
+    uint64_t invalidations() const { return invalidations_.load(); }
+    uint64_t evictions() const { return evictions_.load(); }
+    double hit_ratio() const;
+
+private:
+    struct Key {
+        uint64_t table_id;
+        std::string position;
+        int age_range;
+
+        bool operator==(const Key& other) const {
+            return table_id == other.table_id && age_range == other.age_range &&
+                   position == other.position;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = std::hash<uint64_t>()(key.table_id);
+            h = h * 31 + std::hash<std::string>()(key.position);
+            return h * 31 + std::hash<int>()(key.age_range);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        uint64_t version;
+        QueryResult result;
+    };
+
+    size_t capacity_;
+    std::list<Entry> lru_;   // В начале - самые свежие записи
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entries_;
+    mutable std::mutex mtx_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+// Бенчмарк: повтор неравномерной трассы запросов с кэшем и без него
+void run_cache_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_CACHE_H
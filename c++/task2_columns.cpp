@@ -0,0 +1,348 @@
+#include "task2_columns.h"
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace task2 {
+
+size_t PlainColumns::bytes() const {
+    return position_ids.size() * sizeof(int) + ages.size() * sizeof(int) +
+           salaries.size() * sizeof(double);
+}
+
+size_t PackedColumns::bytes() const {
+    return position_ids.size() + ages.size() + salary_kopecks.size() * sizeof(uint32_t);
+}
+
+size_t BitPackedColumns::bytes() const {
+    return position_ids.bytes() + ages.bytes() + salary_kopecks.bytes();
+}
+
+void BitPackedColumn::encode(const std::vector<uint64_t>& values) {
+    size_ = values.size();
+    base_ = values.empty() ? 0 : *std::min_element(values.begin(), values.end());
+    uint64_t max_offset = values.empty() ? 0 : *std::max_element(values.begin(), values.end()) - base_;
+
+    bits_ = 1;
+    while (bits_ < 64 && (max_offset >> bits_) != 0) {
+        ++bits_;
+    }
+    if (bits_ > 56) {
+        // Чтение одним 64-битным словом со сдвигом до 7 бит: обрезанные
+        // значения декодировались бы неверно
+        throw std::out_of_range("BitPackedColumn: разброс значений не помещается в 56 бит");
+    }
+    mask_ = (uint64_t(1) << bits_) - 1;
+
+    // Запас в 8 байт, чтобы последнее значение читалось целым словом
+    data_.assign((size_ * bits_ + 7) / 8 + sizeof(uint64_t), 0);
+    for (size_t i = 0; i < size_; ++i) {
+        size_t bit = i * bits_;
+        uint64_t word;
+        std::memcpy(&word, data_.data() + bit / 8, sizeof(word));
+        word |= ((values[i] - base_) & mask_) << (bit % 8);
+        std::memcpy(data_.data() + bit / 8, &word, sizeof(word));
+    }
+}
+
+PlainColumns generate_columns(size_t count, int num_positions, uint32_t seed) {
+    PlainColumns columns;
+    columns.position_ids.resize(count);
+    columns.ages.resize(count);
+    columns.salaries.resize(count);
+
+    // Те же распределения, что и в generate_employees
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> age_dist(20, 65);
+    std::uniform_real_distribution<> salary_dist(30000, 300000);
+    std::uniform_int_distribution<> position_dist(0, num_positions - 1);
+
+    for (size_t i = 0; i < count; ++i) {
+        columns.position_ids[i] = position_dist(gen);
+        columns.ages[i] = age_dist(gen);
+        // Зарплата хранится с точностью до копейки
+        columns.salaries[i] = std::round(salary_dist(gen) * 100.0) / 100.0;
+    }
+    return columns;
+}
+
+PackedColumns encode_packed(const PlainColumns& plain) {
+    PackedColumns packed;
+    packed.position_ids.resize(plain.size());
+    packed.ages.resize(plain.size());
+    packed.salary_kopecks.resize(plain.size());
+
+    for (size_t i = 0; i < plain.size(); ++i) {
+        int position_id = plain.position_ids[i];
+        int age = plain.ages[i];
+        long long kopecks = std::llround(plain.salaries[i] * 100.0);
+        if (position_id < 0 || position_id > UINT8_MAX) {
+            throw std::out_of_range("encode_packed: номер должности не помещается в uint8_t");
+        }
+        if (age < 0 || age > UINT8_MAX) {
+            throw std::out_of_range("encode_packed: возраст не помещается в uint8_t");
+        }
+        if (kopecks < 0 || kopecks > static_cast<long long>(UINT32_MAX)) {
+            throw std::out_of_range("encode_packed: зарплата в копейках не помещается в uint32_t");
+        }
+        packed.position_ids[i] = static_cast<uint8_t>(position_id);
+        packed.ages[i] = static_cast<uint8_t>(age);
+        packed.salary_kopecks[i] = static_cast<uint32_t>(kopecks);
+    }
+    return packed;
+}
+
+BitPackedColumns encode_bit_packed(const PlainColumns& plain) {
+    BitPackedColumns packed;
+    std::vector<uint64_t> values(plain.size());
+
+    for (size_t i = 0; i < plain.size(); ++i) values[i] = static_cast<uint64_t>(plain.position_ids[i]);
+    packed.position_ids.encode(values);
+
+    for (size_t i = 0; i < plain.size(); ++i) values[i] = static_cast<uint64_t>(plain.ages[i]);
+    packed.ages.encode(values);
+
+    for (size_t i = 0; i < plain.size(); ++i) {
+        values[i] = static_cast<uint64_t>(std::llround(plain.salaries[i] * 100.0));
+    }
+    packed.salary_kopecks.encode(values);
+
+    return packed;
+}
+
+namespace {
+
+struct CountSumAccumulator {
+    long long count = 0;
+    long long age_sum = 0;
+
+    void merge(const CountSumAccumulator& other) {
+        count += other.count;
+        age_sum += other.age_sum;
+    }
+};
+
+template <typename T>
+struct MaxAccumulator {
+    T max = 0;
+
+    void merge(const MaxAccumulator& other) {
+        if (other.max > max) max = other.max;
+    }
+};
+
+} // namespace
+
+void age_bounds(double average_age, int age_range, long long& lo, long long& hi) {
+    lo = static_cast<long long>(std::ceil(average_age - age_range));
+    hi = static_cast<long long>(std::floor(average_age + age_range));
+    while (std::abs((lo - 1) - average_age) <= age_range) --lo;
+    while (lo <= hi && std::abs(lo - average_age) > age_range) ++lo;
+    while (std::abs((hi + 1) - average_age) <= age_range) ++hi;
+    while (hi >= lo && std::abs(hi - average_age) > age_range) --hi;
+}
+
+QueryResult query_columns(const PlainColumns& c, int position_id, int age_range, ThreadPool& pool) {
+    QueryResult result;
+
+    auto sum = pool.parallel_reduce<CountSumAccumulator>(0, c.size(),
+        [&](size_t begin, size_t end, CountSumAccumulator& acc) {
+            long long count = 0, age_sum = 0;
+            for (size_t i = begin; i < end; ++i) {
+                bool match = c.position_ids[i] == position_id;
+                count += match;
+                age_sum += match ? c.ages[i] : 0;
+            }
+            acc.count += count;
+            acc.age_sum += age_sum;
+        });
+
+    if (sum.count == 0) return result;
+    result.count = static_cast<int>(sum.count);
+    result.average_age = static_cast<double>(sum.age_sum) / sum.count;
+
+    long long lo, hi;
+    age_bounds(result.average_age, age_range, lo, hi);
+
+    auto best = pool.parallel_reduce<MaxAccumulator<double>>(0, c.size(),
+        [&](size_t begin, size_t end, MaxAccumulator<double>& acc) {
+            double local = acc.max;
+            for (size_t i = begin; i < end; ++i) {
+                bool match = c.position_ids[i] == position_id && c.ages[i] >= lo && c.ages[i] <= hi;
+                double candidate = match ? c.salaries[i] : 0.0;
+                local = candidate > local ? candidate : local;
+            }
+            acc.max = local;
+        });
+
+    result.max_salary = best.max;
+    return result;
+}
+
+QueryResult query_columns(const PackedColumns& c, int position_id, int age_range, ThreadPool& pool) {
+    QueryResult result;
+    if (position_id < 0 || position_id > 255) return result;
+    uint8_t pid = static_cast<uint8_t>(position_id);
+
+    auto sum = pool.parallel_reduce<CountSumAccumulator>(0, c.size(),
+        [&](size_t begin, size_t end, CountSumAccumulator& acc) {
+            long long count = 0, age_sum = 0;
+            for (size_t i = begin; i < end; ++i) {
+                bool match = c.position_ids[i] == pid;
+                count += match;
+                age_sum += match ? c.ages[i] : 0;
+            }
+            acc.count += count;
+            acc.age_sum += age_sum;
+        });
+
+    if (sum.count == 0) return result;
+    result.count = static_cast<int>(sum.count);
+    result.average_age = static_cast<double>(sum.age_sum) / sum.count;
+
+    long long lo, hi;
+    age_bounds(result.average_age, age_range, lo, hi);
+
+    auto best = pool.parallel_reduce<MaxAccumulator<uint32_t>>(0, c.size(),
+        [&](size_t begin, size_t end, MaxAccumulator<uint32_t>& acc) {
+            uint32_t local = acc.max;
+            for (size_t i = begin; i < end; ++i) {
+                bool match = c.position_ids[i] == pid && c.ages[i] >= lo && c.ages[i] <= hi;
+                uint32_t candidate = match ? c.salary_kopecks[i] : 0;
+                local = candidate > local ? candidate : local;
+            }
+            acc.max = local;
+        });
+
+    result.max_salary = best.max / 100.0;
+    return result;
+}
+
+QueryResult query_columns(const BitPackedColumns& c, int position_id, int age_range, ThreadPool& pool) {
+    QueryResult result;
+
+    // Все сравнения - в закодированной области (смещения от base)
+    uint64_t pid_base = c.position_ids.base();
+    if (position_id < 0 || static_cast<uint64_t>(position_id) < pid_base) return result;
+    uint64_t pid = static_cast<uint64_t>(position_id) - pid_base;
+
+    auto sum = pool.parallel_reduce<CountSumAccumulator>(0, c.size(),
+        [&](size_t begin, size_t end, CountSumAccumulator& acc) {
+            long long count = 0, age_sum = 0;
+            for (size_t i = begin; i < end; ++i) {
+                bool match = c.position_ids.get_offset(i) == pid;
+                count += match;
+                age_sum += match ? static_cast<long long>(c.ages.get_offset(i)) : 0;
+            }
+            acc.count += count;
+            acc.age_sum += age_sum;
+        });
+
+    if (sum.count == 0) return result;
+    result.count = static_cast<int>(sum.count);
+    double age_total = static_cast<double>(sum.age_sum) +
+                       static_cast<double>(c.ages.base()) * sum.count;
+    result.average_age = age_total / sum.count;
+
+    long long lo, hi;
+    age_bounds(result.average_age, age_range, lo, hi);
+    long long age_base = static_cast<long long>(c.ages.base());
+    if (hi < age_base) return result;
+    uint64_t lo_offset = lo > age_base ? static_cast<uint64_t>(lo - age_base) : 0;
+    uint64_t hi_offset = static_cast<uint64_t>(hi - age_base);
+
+    auto best = pool.parallel_reduce<MaxAccumulator<uint64_t>>(0, c.size(),
+        [&](size_t begin, size_t end, MaxAccumulator<uint64_t>& acc) {
+            // Максимум храним как смещение + 1, чтобы 0 означал "нет строк"
+            uint64_t local = acc.max;
+            for (size_t i = begin; i < end; ++i) {
+                uint64_t age = c.ages.get_offset(i);
+                bool match = c.position_ids.get_offset(i) == pid && age >= lo_offset && age <= hi_offset;
+                uint64_t candidate = match ? c.salary_kopecks.get_offset(i) + 1 : 0;
+                local = candidate > local ? candidate : local;
+            }
+            acc.max = local;
+        });
+
+    if (best.max > 0) {
+        result.max_salary = (c.salary_kopecks.base() + best.max - 1) / 100.0;
+    }
+    return result;
+}
+
+void run_columns_benchmark(size_t max_rows) {
+    std::cout << "\n=== Бенчмарк сжатых кодировок столбцов ===\n";
+
+    const int num_positions = 8;
+    const int target_position_id = num_positions - 1;
+    const int repeats = 5;
+    int num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    std::cout << "Потоков: " << num_threads << "\n\n";
+    std::cout << std::setw(12) << "Строк"
+              << std::setw(16) << "Кодировка"
+              << std::setw(14) << "Память (МБ)"
+              << std::setw(14) << "Байт/строку"
+              << std::setw(14) << "Запрос (мс)"
+              << std::setw(16) << "Млн строк/с"
+              << std::setw(12) << "ГБ/с" << "\n";
+    std::cout << std::string(98, '-') << std::endl;
+
+    for (size_t rows = 1000000; rows <= max_rows; rows *= 10) {
+        PlainColumns plain = generate_columns(rows, num_positions);
+        PackedColumns packed = encode_packed(plain);
+        BitPackedColumns bit_packed = encode_bit_packed(plain);
+
+        QueryResult reference;
+        auto measure = [&](const std::string& name, size_t bytes, auto&& query) {
+            QueryResult result;
+            Benchmark b(name, false);
+            for (int r = 0; r < repeats; ++r) {
+                result = query();
+            }
+            double time = b.elapsed_microseconds() / repeats;
+
+            if (name == "Без сжатия") {
+                reference = result;
+            } else if (result.count != reference.count ||
+                       std::llround(result.max_salary * 100) != std::llround(reference.max_salary * 100)) {
+                std::cerr << "Ошибка: кодировка '" << name << "' дала другой результат\n";
+            }
+
+            // Запрос дважды просматривает столбцы
+            double seconds = time / 1e6;
+            std::cout << std::setw(12) << rows
+                      << std::setw(16) << name
+                      << std::setw(14) << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024.0)
+                      << std::setw(14) << std::fixed << std::setprecision(2) << static_cast<double>(bytes) / rows
+                      << std::setw(14) << std::fixed << std::setprecision(2) << time / 1000.0
+                      << std::setw(16) << std::fixed << std::setprecision(1) << 2.0 * rows / seconds / 1e6
+                      << std::setw(12) << std::fixed << std::setprecision(2) << 2.0 * bytes / seconds / 1e9 << "\n";
+
+            benchmark_results.emplace_back(std::to_string(rows) + "_" + name, time);
+        };
+
+        measure("Без сжатия", plain.bytes(),
+                [&]() { return query_columns(plain, target_position_id, 2, pool); });
+        measure("Упакованная", packed.bytes(),
+                [&]() { return query_columns(packed, target_position_id, 2, pool); });
+        measure("Битовая", bit_packed.bytes(),
+                [&]() { return query_columns(bit_packed, target_position_id, 2, pool); });
+
+        std::cout << "  Ширина битовых столбцов: должность " << bit_packed.position_ids.bits()
+                  << ", возраст " << bit_packed.ages.bits()
+                  << ", зарплата " << bit_packed.salary_kopecks.bits() << " бит\n";
+    }
+
+    Benchmark::save_to_csv(benchmark_results, "columns_benchmark.csv");
+}
+
+} // namespace task2
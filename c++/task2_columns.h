@@ -0,0 +1,92 @@
+#ifndef TASK2_COLUMNS_H
+#define TASK2_COLUMNS_H
+
+#include "task2_employees.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace task2 {
+
+// Несжатые столбцы: номер должности, возраст, зарплата (16 байт на строку)
+struct PlainColumns {
+    std::vector<int> position_ids;
+    std::vector<int> ages;
+    std::vector<double> salaries;
+
+    size_t size() const { return ages.size(); }
+    size_t bytes() const;
+};
+
+// Упакованные столбцы: возраст и должность в uint8_t, зарплата в копейках
+// в uint32_t (6 байт на строку)
+struct PackedColumns {
+    std::vector<uint8_t> position_ids;
+    std::vector<uint8_t> ages;
+    std::vector<uint32_t> salary_kopecks;
+
+    size_t size() const { return ages.size(); }
+    size_t bytes() const;
+};
+
+// Столбец с отсчетом от минимума (frame of reference) и упаковкой
+// значений фиксированной ширины bits подряд в байтовый массив
+class BitPackedColumn {
+public:
+    // std::out_of_range, если разброс значений шире 56 бит
+    void encode(const std::vector<uint64_t>& values);
+
+    // Значение без прибавления base()
+    uint64_t get_offset(size_t i) const {
+        size_t bit = i * bits_;
+        uint64_t word;
+        std::memcpy(&word, data_.data() + bit / 8, sizeof(word));
+        return (word >> (bit % 8)) & mask_;
+    }
+
+    uint64_t get(size_t i) const { return base_ + get_offset(i); }
+
+    uint64_t base() const { return base_; }
+    int bits() const { return bits_; }
+    size_t size() const { return size_; }
+    size_t bytes() const { return data_.size(); }
+
+private:
+    std::vector<uint8_t> data_;
+    uint64_t base_ = 0;
+    uint64_t mask_ = 0;
+    int bits_ = 0;
+    size_t size_ = 0;
+};
+
+struct BitPackedColumns {
+    BitPackedColumn position_ids;
+    BitPackedColumn ages;
+    BitPackedColumn salary_kopecks;
+
+    size_t size() const { return ages.size(); }
+    size_t bytes() const;
+};
+
+// Столбцы генерируются напрямую, без строк ФИО и должностей
+PlainColumns generate_columns(size_t count, int num_positions, uint32_t seed = 26);
+
+// std::out_of_range, если значение не помещается в свой тип
+PackedColumns encode_packed(const PlainColumns& plain);
+BitPackedColumns encode_bit_packed(const PlainColumns& plain);
+
+// Целые границы возраста, совпадающие с условием |age - avg| <= age_range
+void age_bounds(double average_age, int age_range, long long& lo, long long& hi);
+
+// Запрос варианта 26 с декодированием внутри фильтра и свертки
+QueryResult query_columns(const PlainColumns& columns, int position_id, int age_range, ThreadPool& pool);
+QueryResult query_columns(const PackedColumns& columns, int position_id, int age_range, ThreadPool& pool);
+QueryResult query_columns(const BitPackedColumns& columns, int position_id, int age_range, ThreadPool& pool);
+
+// Бенчмарк: объем памяти и скорость просмотра каждой кодировки
+void run_columns_benchmark(size_t max_rows = 100000000);
+
+} // namespace task2
+
+#endif // TASK2_COLUMNS_H
@@ -1,11 +1,22 @@
 #include "task2_employees.h"
+#include "task2_table.h"
+#include "task2_sorted.h"
+#include "task2_incremental.h"
+#include "task2_batch.h"
+#include "task2_cache.h"
+#include "task2_snapshot.h"
+#include "task2_columns.h"
+#include "task2_topk.h"
+#include "task2_query.h"
+#include "task2_stream.h"
+#include "task2_pipeline.h"
+#include "task2_shards.h"
 #include "benchmark_utils.h"
+#include "thread_pool.h"
 #include <iostream>
-#include <thread>
 #include <vector>
 #include <random>
 #include <algorithm>
-#include <mutex>
 #include <iomanip>
 #include <cmath>
 #include <sstream>
@@ -13,9 +24,13 @@
 namespace task2 {
 
 std::vector<Employee> generate_employees(int count, const std::string& target_position) {
-    std::vector<Employee> employees;
     std::random_device rd;
-    std::mt19937 gen(rd());
+    return generate_employees(count, target_position, rd());
+}
+
+std::vector<Employee> generate_employees(int count, const std::string& target_position, uint32_t seed) {
+    std::vector<Employee> employees;
+    std::mt19937 gen(seed);
     
     // Списки для генерации данных
     std::vector<std::string> first_names = {"Иван", "Петр", "Сергей", "Алексей", "Дмитрий", 
@@ -130,99 +145,103 @@ void process_single_thread(const std::vector<Employee>& employees,
     }
 }
 
-void process_multi_thread(const std::vector<Employee>& employees, 
-                         const std::string& target_position, 
-                         int num_threads) {
-    if (employees.empty()) {
-        std::cout << "Нет данных для обработки\n";
-        return;
+namespace {
+
+// Аккумулятор первой фазы: сумма возрастов и количество
+struct AgeAccumulator {
+    double total_age = 0.0;
+    int count = 0;
+
+    void merge(const AgeAccumulator& other) {
+        total_age += other.total_age;
+        count += other.count;
     }
-    
-    std::vector<std::thread> threads;
-    std::vector<double> thread_ages(num_threads, 0.0);
-    std::vector<int> thread_counts(num_threads, 0);
-    std::vector<double> thread_max_salaries(num_threads, 0.0);
-    
-    int chunk_size = employees.size() / num_threads;
-    std::mutex cout_mutex;
-    
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            int start = i * chunk_size;
-            int end = (i == num_threads - 1) ? employees.size() : start + chunk_size;
-            
-            for (int j = start; j < end; ++j) {
+};
+
+// Аккумулятор второй фазы: максимальная зарплата
+struct MaxSalaryAccumulator {
+    double max_salary = 0.0;
+
+    void merge(const MaxSalaryAccumulator& other) {
+        if (other.max_salary > max_salary) {
+            max_salary = other.max_salary;
+        }
+    }
+};
+
+template <bool Padded>
+QueryResult compute_with_pool(ThreadPool& pool,
+                              const std::vector<Employee>& employees,
+                              const std::string& target_position,
+                              int age_range) {
+    QueryResult result;
+
+    // Первая фаза: сумма возрастов и количество сотрудников с должностью
+    AgeAccumulator sum = pool.parallel_reduce<AgeAccumulator, Padded>(
+        0, employees.size(),
+        [&](size_t begin, size_t end, AgeAccumulator& acc) {
+            for (size_t j = begin; j < end; ++j) {
                 const auto& emp = employees[j];
                 if (emp.position == target_position) {
-                    thread_ages[i] += emp.age;
-                    thread_counts[i]++;
-                    
-                    // Пока не знаем средний возраст, сохраняем максимальную зарплату
-                    if (emp.salary > thread_max_salaries[i]) {
-                        thread_max_salaries[i] = emp.salary;
-                    }
+                    acc.total_age += emp.age;
+                    acc.count++;
                 }
             }
         });
-    }
-    
-    for (auto& t : threads) {
-        t.join();
-    }
-    
-    // Агрегируем результаты
-    double total_age = 0.0;
-    int total_count = 0;
-    
-    for (int i = 0; i < num_threads; ++i) {
-        total_age += thread_ages[i];
-        total_count += thread_counts[i];
-    }
-    
-    double average_age = total_count > 0 ? total_age / total_count : 0.0;
-    
+
+    result.count = sum.count;
+    result.average_age = sum.count > 0 ? sum.total_age / sum.count : 0.0;
+    double average_age = result.average_age;
+
     // Вторая фаза: поиск максимальной зарплаты с учетом среднего возраста
-    threads.clear();
-    std::vector<double> thread_phase2_max(num_threads, 0.0);
-    
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i, average_age]() {
-            int start = i * chunk_size;
-            int end = (i == num_threads - 1) ? employees.size() : start + chunk_size;
-            
-            for (int j = start; j < end; ++j) {
+    MaxSalaryAccumulator best = pool.parallel_reduce<MaxSalaryAccumulator, Padded>(
+        0, employees.size(),
+        [&](size_t begin, size_t end, MaxSalaryAccumulator& acc) {
+            for (size_t j = begin; j < end; ++j) {
                 const auto& emp = employees[j];
-                if (emp.position == target_position && 
-                    std::abs(emp.age - average_age) <= 2) {
-                    if (emp.salary > thread_phase2_max[i]) {
-                        thread_phase2_max[i] = emp.salary;
+                if (emp.position == target_position &&
+                    std::abs(emp.age - average_age) <= age_range) {
+                    if (emp.salary > acc.max_salary) {
+                        acc.max_salary = emp.salary;
                     }
                 }
             }
         });
+
+    result.max_salary = best.max_salary;
+    return result;
+}
+
+} // namespace
+
+QueryResult compute_multi_thread(const std::vector<Employee>& employees,
+                                 const std::string& target_position,
+                                 int num_threads,
+                                 int age_range) {
+    return compute_with_pool<true>(ThreadPool::shared(num_threads),
+                                   employees, target_position, age_range);
+}
+
+void process_multi_thread(const std::vector<Employee>& employees, 
+                         const std::string& target_position, 
+                         int num_threads) {
+    if (employees.empty()) {
+        std::cout << "Нет данных для обработки\n";
+        return;
     }
     
-    for (auto& t : threads) {
-        t.join();
-    }
-    
-    double max_salary = 0.0;
-    for (int i = 0; i < num_threads; ++i) {
-        if (thread_phase2_max[i] > max_salary) {
-            max_salary = thread_phase2_max[i];
-        }
-    }
+    QueryResult result = compute_multi_thread(employees, target_position, num_threads);
     
     std::cout << "\n=== Результаты обработки (многопоточная) ===\n";
     std::cout << "Использовано потоков: " << num_threads << "\n";
     std::cout << "Всего сотрудников: " << employees.size() << "\n";
-    std::cout << "Сотрудников с должностью '" << target_position << "': " << total_count << "\n\n";
+    std::cout << "Сотрудников с должностью '" << target_position << "': " << result.count << "\n\n";
     
-    if (total_count > 0) {
-        std::cout << "Средний возраст: " << std::fixed << std::setprecision(2) << average_age << " лет\n";
+    if (result.count > 0) {
+        std::cout << "Средний возраст: " << std::fixed << std::setprecision(2) << result.average_age << " лет\n";
         std::cout << "Максимальная зарплата среди сотрудников\n";
         std::cout << "с возрастом ±2 года от среднего: " 
-                  << std::fixed << std::setprecision(2) << max_salary << " руб.\n";
+                  << std::fixed << std::setprecision(2) << result.max_salary << " руб.\n";
     } else {
         std::cout << "Нет сотрудников с должностью '" << target_position << "'\n";
     }
@@ -314,6 +333,59 @@ void run_employees_benchmark() {
     std::cout << "\nБенчмарк завершен. Результаты сохранены в employees_benchmark.csv\n";
 }
 
+void run_reduction_benchmark() {
+    std::cout << "\n=== Бенчмарк свертки: выровненные и невыровненные аккумуляторы ===\n";
+    
+    std::string target_position = "Инженер";
+    std::vector<int> test_sizes = {100000, 500000, 1000000};
+    std::vector<int> thread_counts = {2, 4, 8};
+    const int repeats = 10;
+    
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    
+    std::cout << std::setw(10) << "Размер"
+              << std::setw(10) << "Потоки"
+              << std::setw(22) << "Выровненные (мкс)"
+              << std::setw(24) << "Невыровненные (мкс)" << "\n";
+    std::cout << std::string(66, '-') << std::endl;
+    
+    for (int size : test_sizes) {
+        auto employees = generate_employees(size, target_position);
+        
+        for (int threads : thread_counts) {
+            ThreadPool& pool = ThreadPool::shared(threads);
+            double padded_time, unpadded_time;
+            
+            {
+                Benchmark b("Выровненные", false);
+                for (int r = 0; r < repeats; ++r) {
+                    compute_with_pool<true>(pool, employees, target_position, 2);
+                }
+                padded_time = b.elapsed_microseconds() / repeats;
+            }
+            
+            {
+                Benchmark b("Невыровненные", false);
+                for (int r = 0; r < repeats; ++r) {
+                    compute_with_pool<false>(pool, employees, target_position, 2);
+                }
+                unpadded_time = b.elapsed_microseconds() / repeats;
+            }
+            
+            std::string prefix = std::to_string(size) + "_сотр_" + std::to_string(threads) + "_потоков";
+            benchmark_results.emplace_back(prefix + "_выровн", padded_time);
+            benchmark_results.emplace_back(prefix + "_невыровн", unpadded_time);
+            
+            std::cout << std::setw(10) << size
+                      << std::setw(10) << threads
+                      << std::setw(22) << std::fixed << std::setprecision(2) << padded_time
+                      << std::setw(24) << std::fixed << std::setprecision(2) << unpadded_time << "\n";
+        }
+    }
+    
+    Benchmark::save_to_csv(benchmark_results, "reduction_benchmark.csv");
+}
+
 void run_employees() {
     std::cout << "\n=== Задание 2: Анализ сотрудников (вариант 26) ===\n";
     std::cout << "Найти средний возраст для должности Д\n";
@@ -325,6 +397,20 @@ void run_employees() {
     std::cout << "1. Стандартный анализ\n";
     std::cout << "2. Анализ производительности\n";
     std::cout << "3. Полный бенчмарк\n";
+    std::cout << "4. Бенчмарк свертки (ложное разделение)\n";
+    std::cout << "5. Бенчмарк индекса по должности\n";
+    std::cout << "6. Бенчмарк упорядоченной раскладки\n";
+    std::cout << "7. Бенчмарк инкрементального хранилища\n";
+    std::cout << "8. Пакетный запрос по всем должностям\n";
+    std::cout << "9. Бенчмарк кэша результатов\n";
+    std::cout << "10. Бенчмарк таблицы со снимками\n";
+    std::cout << "11. Бенчмарк сжатых кодировок столбцов\n";
+    std::cout << "12. Бенчмарк метаданных блоков (zone maps)\n";
+    std::cout << "13. Бенчмарк top-K и квантилей\n";
+    std::cout << "14. Бенчмарк запросов на шаблонах выражений\n";
+    std::cout << "15. Потоковый просмотр таблицы с диска\n";
+    std::cout << "16. Конвейер: генерация, разбор, агрегация\n";
+    std::cout << "17. Процессы с общей памятью\n";
     std::cout << "Ваш выбор: ";
     std::cin >> choice;
     
@@ -381,6 +467,48 @@ void run_employees() {
         case 3:
             run_employees_benchmark();
             break;
+        case 4:
+            run_reduction_benchmark();
+            break;
+        case 5:
+            run_index_benchmark();
+            break;
+        case 6:
+            run_sorted_benchmark();
+            break;
+        case 7:
+            run_incremental_benchmark();
+            break;
+        case 8:
+            run_batch_benchmark();
+            break;
+        case 9:
+            run_cache_benchmark();
+            break;
+        case 10:
+            run_snapshot_benchmark();
+            break;
+        case 11:
+            run_columns_benchmark();
+            break;
+        case 12:
+            run_zone_map_benchmark();
+            break;
+        case 13:
+            run_topk_benchmark();
+            break;
+        case 14:
+            run_query_benchmark();
+            break;
+        case 15:
+            run_stream_benchmark();
+            break;
+        case 16:
+            run_pipeline_benchmark();
+            break;
+        case 17:
+            run_shards_benchmark();
+            break;
         default:
             std::cout << "Неверный выбор! Запускаю стандартный анализ...\n";
             auto employees = generate_employees(5000, target_position);
@@ -1,6 +1,7 @@
 #ifndef TASK2_EMPLOYEES_H
 #define TASK2_EMPLOYEES_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -17,12 +18,22 @@ struct Employee {
         : name(n), position(p), age(a), salary(s) {}
 };
 
+// Результат запроса варианта 26 для одной должности
+struct QueryResult {
+    int count = 0;              // Сотрудников с должностью
+    double average_age = 0.0;   // Средний возраст
+    double max_salary = 0.0;    // Максимальная зарплата в окрестности среднего
+};
+
 // Основные функции
 void run_employees();
 void run_employees_benchmark();
+void run_reduction_benchmark();
 
 // Вспомогательные функции
 std::vector<Employee> generate_employees(int count, const std::string& target_position);
+// Воспроизводимая генерация с заданным зерном
+std::vector<Employee> generate_employees(int count, const std::string& target_position, uint32_t seed);
 double calculate_average_age(const std::vector<Employee>& employees, const std::string& target_position);
 double find_max_salary_near_average(const std::vector<Employee>& employees, 
                                    const std::string& target_position, 
@@ -36,6 +47,12 @@ void process_multi_thread(const std::vector<Employee>& employees,
                          const std::string& target_position, 
                          int num_threads);
 
+// Многопоточный расчет без вывода (через общий пул потоков)
+QueryResult compute_multi_thread(const std::vector<Employee>& employees,
+                                 const std::string& target_position,
+                                 int num_threads,
+                                 int age_range = 2);
+
 // Анализ производительности
 void analyze_performance(int min_size, int max_size, int step, 
                         const std::string& target_position);
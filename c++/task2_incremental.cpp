@@ -0,0 +1,232 @@
+#include "task2_incremental.h"
+#include "benchmark_utils.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <random>
+
+namespace task2 {
+
+IncrementalEmployeeStore::RowId IncrementalEmployeeStore::insert(const Employee& employee) {
+    RowId id;
+    if (!free_ids_.empty()) {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+        rows_[id] = employee;
+        alive_[id] = true;
+    } else {
+        id = static_cast<RowId>(rows_.size());
+        rows_.push_back(employee);
+        alive_.push_back(true);
+    }
+
+    add_to_state(employee);
+    live_count_++;
+    return id;
+}
+
+bool IncrementalEmployeeStore::update(RowId id, const Employee& employee) {
+    if (!contains(id)) return false;
+
+    remove_from_state(rows_[id]);
+    rows_[id] = employee;
+    add_to_state(employee);
+    return true;
+}
+
+bool IncrementalEmployeeStore::erase(RowId id) {
+    if (!contains(id)) return false;
+
+    remove_from_state(rows_[id]);
+    alive_[id] = false;
+    free_ids_.push_back(id);
+    live_count_--;
+    return true;
+}
+
+bool IncrementalEmployeeStore::contains(RowId id) const {
+    return id >= 0 && id < static_cast<RowId>(rows_.size()) && alive_[id];
+}
+
+void IncrementalEmployeeStore::add_to_state(const Employee& employee) {
+    auto& state = positions_[employee.position];
+    state.count++;
+    state.age_sum += employee.age;
+    state.salaries_by_age[employee.age].insert(employee.salary);
+}
+
+void IncrementalEmployeeStore::remove_from_state(const Employee& employee) {
+    auto& state = positions_[employee.position];
+    state.count--;
+    state.age_sum -= employee.age;
+
+    auto age_it = state.salaries_by_age.find(employee.age);
+    age_it->second.erase(age_it->second.find(employee.salary));
+    if (age_it->second.empty()) {
+        state.salaries_by_age.erase(age_it);
+    }
+}
+
+QueryResult IncrementalEmployeeStore::query(const std::string& target_position, int age_range) const {
+    QueryResult result;
+
+    auto it = positions_.find(target_position);
+    if (it == positions_.end() || it->second.count == 0) {
+        return result;
+    }
+
+    const auto& state = it->second;
+    result.count = state.count;
+    result.average_age = static_cast<double>(state.age_sum) / state.count;
+
+    // Возрасты в окрестности среднего: не больше 2 * age_range + 1 ключей
+    auto age_it = state.salaries_by_age.lower_bound(
+        static_cast<int>(std::floor(result.average_age - age_range)));
+    for (; age_it != state.salaries_by_age.end(); ++age_it) {
+        int age = age_it->first;
+        if (age - result.average_age > age_range) break;
+        if (result.average_age - age > age_range) continue;
+
+        double best = *age_it->second.rbegin();
+        if (best > result.max_salary) {
+            result.max_salary = best;
+        }
+    }
+
+    return result;
+}
+
+void run_incremental_benchmark() {
+    std::cout << "\n=== Бенчмарк инкрементального хранилища ===\n";
+
+    std::string target_position = "Инженер";
+    const int initial_size = 100000;
+    const int num_operations = 5000;
+
+    // Пул сотрудников, из которого берутся вставляемые и измененные строки
+    auto initial = generate_employees(initial_size, target_position);
+    auto incoming = generate_employees(num_operations, target_position);
+
+    IncrementalEmployeeStore store;
+    std::vector<IncrementalEmployeeStore::RowId> live_ids;
+    for (const auto& emp : initial) {
+        live_ids.push_back(store.insert(emp));
+    }
+
+    // Базовый вариант: вектор строк и полный пересчет на каждый запрос
+    std::vector<Employee> baseline = initial;
+    std::vector<size_t> baseline_index(initial_size);
+    std::vector<IncrementalEmployeeStore::RowId> baseline_owner(initial_size);
+    for (int i = 0; i < initial_size; ++i) {
+        baseline_index[live_ids[i]] = i;
+        baseline_owner[i] = live_ids[i];
+    }
+
+    // Трасса: 30% вставок, 25% изменений, 25% удалений, 20% запросов
+    enum class Op { INSERT, UPDATE, ERASE, QUERY };
+    std::mt19937 gen(26);
+    std::uniform_int_distribution<> op_dist(0, 99);
+    std::vector<Op> trace;
+    for (int i = 0; i < num_operations; ++i) {
+        int r = op_dist(gen);
+        trace.push_back(r < 30 ? Op::INSERT : r < 55 ? Op::UPDATE : r < 80 ? Op::ERASE : Op::QUERY);
+    }
+
+    // Вставка или удаление - O(log n), быстрее микросекунды: суммы в нс
+    using Clock = std::chrono::steady_clock;
+    std::chrono::nanoseconds incremental_ns{0}, recompute_ns{0};
+    int mismatches = 0, queries = 0;
+
+    for (int i = 0; i < num_operations; ++i) {
+        const Employee& emp = incoming[i];
+        size_t victim = gen() % live_ids.size();
+        IncrementalEmployeeStore::RowId id = live_ids[victim];
+        QueryResult fast, slow;
+
+        {
+            auto start = Clock::now();
+            switch (trace[i]) {
+                case Op::INSERT: {
+                    IncrementalEmployeeStore::RowId new_id = store.insert(emp);
+                    live_ids.push_back(new_id);
+                    id = new_id;
+                    break;
+                }
+                case Op::UPDATE:
+                    store.update(id, emp);
+                    break;
+                case Op::ERASE:
+                    store.erase(id);
+                    live_ids[victim] = live_ids.back();
+                    live_ids.pop_back();
+                    break;
+                case Op::QUERY:
+                    fast = store.query(target_position);
+                    break;
+            }
+            incremental_ns += Clock::now() - start;
+        }
+
+        {
+            auto start = Clock::now();
+            switch (trace[i]) {
+                case Op::INSERT:
+                    if (static_cast<size_t>(id) >= baseline_index.size()) {
+                        baseline_index.resize(id + 1);
+                    }
+                    baseline_index[id] = baseline.size();
+                    baseline.push_back(emp);
+                    baseline_owner.push_back(id);
+                    break;
+                case Op::UPDATE:
+                    baseline[baseline_index[id]] = emp;
+                    break;
+                case Op::ERASE: {
+                    size_t pos = baseline_index[id];
+                    baseline[pos] = baseline.back();
+                    baseline_owner[pos] = baseline_owner.back();
+                    baseline_index[baseline_owner[pos]] = pos;
+                    baseline.pop_back();
+                    baseline_owner.pop_back();
+                    break;
+                }
+                case Op::QUERY:
+                    slow.average_age = calculate_average_age(baseline, target_position);
+                    slow.max_salary = find_max_salary_near_average(baseline, target_position,
+                                                                   slow.average_age);
+                    break;
+            }
+            recompute_ns += Clock::now() - start;
+        }
+
+        if (trace[i] == Op::QUERY) {
+            queries++;
+            if (std::abs(fast.average_age - slow.average_age) > 1e-9 ||
+                fast.max_salary != slow.max_salary) {
+                mismatches++;
+            }
+        }
+    }
+
+    double incremental_time = incremental_ns.count() / 1000.0;
+    double recompute_time = recompute_ns.count() / 1000.0;
+
+    if (mismatches > 0) {
+        std::cerr << "Ошибка: " << mismatches << " ответов не совпали с пересчетом\n";
+    }
+
+    std::cout << "Начальный размер: " << initial_size << ", операций: " << num_operations
+              << " (из них запросов: " << queries << ")\n";
+    std::cout << "Итоговый размер: " << store.size() << "\n";
+
+    std::vector<std::pair<std::string, double>> benchmark_results = {
+        {"Инкрементально", incremental_time},
+        {"Пересчет_с_нуля", recompute_time}
+    };
+
+    Benchmark::print_comparison("Пересчет с нуля", recompute_time, "Инкрементально", incremental_time);
+    Benchmark::save_to_csv(benchmark_results, "incremental_benchmark.csv");
+}
+
+} // namespace task2
@@ -0,0 +1,53 @@
+#ifndef TASK2_INCREMENTAL_H
+#define TASK2_INCREMENTAL_H
+
+#include "task2_employees.h"
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace task2 {
+
+// Изменяемое хранилище сотрудников с инкрементальным поддержанием ответа
+// варианта 26. Для каждой должности хранятся (количество, сумма возрастов)
+// и мультимножества зарплат по возрастам, поэтому после каждой вставки,
+// изменения или удаления запрос отвечается за O(log n).
+class IncrementalEmployeeStore {
+public:
+    using RowId = int;
+
+    RowId insert(const Employee& employee);
+    bool update(RowId id, const Employee& employee);
+    bool erase(RowId id);
+
+    bool contains(RowId id) const;
+    const Employee& get(RowId id) const { return rows_[id]; }
+    size_t size() const { return live_count_; }
+
+    QueryResult query(const std::string& target_position, int age_range = 2) const;
+
+private:
+    struct PositionState {
+        int count = 0;
+        long long age_sum = 0;
+        std::map<int, std::multiset<double>> salaries_by_age;
+    };
+
+    std::unordered_map<std::string, PositionState> positions_;
+    std::vector<Employee> rows_;
+    std::vector<bool> alive_;
+    std::vector<RowId> free_ids_;
+    size_t live_count_ = 0;
+
+    void add_to_state(const Employee& employee);
+    void remove_from_state(const Employee& employee);
+};
+
+// Бенчмарк смешанной нагрузки: изменения вперемешку с запросами
+void run_incremental_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_INCREMENTAL_H
@@ -0,0 +1,443 @@
+#include "task2_pipeline.h"
+#include "task2_batch.h"
+#include "bounded_queue.h"
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+namespace task2 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using RowBatch = std::vector<Employee>;
+using TextBlock = std::string;
+
+uint64_t nanoseconds_since(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+struct StageCounters {
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> rows{0};
+    std::atomic<uint64_t> busy_ns{0};
+    std::atomic<uint64_t> blocked_ns{0};
+    std::atomic<uint64_t> starved_ns{0};
+
+    void add_batch(size_t batch_rows, Clock::time_point work_start) {
+        busy_ns += nanoseconds_since(work_start);
+        batches++;
+        rows += batch_rows;
+    }
+
+    StageStats snapshot(const std::string& name, int workers) const {
+        StageStats stats;
+        stats.name = name;
+        stats.workers = workers;
+        stats.batches = batches.load();
+        stats.rows = rows.load();
+        stats.busy_seconds = busy_ns.load() / 1e9;
+        stats.blocked_seconds = blocked_ns.load() / 1e9;
+        stats.starved_seconds = starved_ns.load() / 1e9;
+        return stats;
+    }
+};
+
+template <typename T>
+void timed_push(BoundedQueue<T>& queue, T value, StageCounters& counters) {
+    auto start = Clock::now();
+    queue.push(std::move(value));
+    counters.blocked_ns += nanoseconds_since(start);
+}
+
+template <typename T>
+bool timed_pop(BoundedQueue<T>& queue, T& value, StageCounters& counters) {
+    auto start = Clock::now();
+    bool ok = queue.pop(value);
+    counters.starved_ns += nanoseconds_since(start);
+    return ok;
+}
+
+// Последний завершившийся поток стадии закрывает ее выходную очередь
+template <typename T>
+void finish_producer(std::atomic<int>& active, BoundedQueue<T>& output) {
+    if (active.fetch_sub(1) == 1) {
+        output.close();
+    }
+}
+
+// Разбор строки "name,position,age,salary"; end указывает на конец строки
+bool parse_employee_line(const char* begin, const char* end, Employee& emp) {
+    const char* name_end = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+    if (!name_end) return false;
+    const char* position_end = static_cast<const char*>(std::memchr(name_end + 1, ',', end - name_end - 1));
+    if (!position_end) return false;
+
+    char* number_end = nullptr;
+    long age = std::strtol(position_end + 1, &number_end, 10);
+    if (number_end == position_end + 1 || number_end >= end || *number_end != ',') return false;
+    const char* salary_begin = number_end + 1;
+    double salary = std::strtod(salary_begin, &number_end);
+    if (number_end == salary_begin) return false;
+
+    emp.name.assign(begin, name_end);
+    emp.position.assign(name_end + 1, position_end);
+    emp.age = static_cast<int>(age);
+    emp.salary = salary;
+    return true;
+}
+
+// Разбор блока строк; некорректные строки пропускаются
+RowBatch parse_block(const TextBlock& block, size_t& bad_lines) {
+    RowBatch batch;
+    const char* p = block.data();
+    const char* end = p + block.size();
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!line_end) line_end = end;
+        if (line_end > p) {
+            Employee emp;
+            if (parse_employee_line(p, line_end, emp)) {
+                batch.push_back(std::move(emp));
+            } else {
+                bad_lines++;
+            }
+        }
+        p = line_end + 1;
+    }
+    return batch;
+}
+
+// Агрегаторы: гистограмма возрастов целевой должности у каждого потока,
+// объединение после закрытия входной очереди
+void aggregate_batches(BoundedQueue<RowBatch>& input, const std::string& target_position,
+                       StageCounters& counters, std::mutex& total_mutex, DenseAgeHistogram& total) {
+    DenseAgeHistogram local;
+    RowBatch batch;
+    while (timed_pop(input, batch, counters)) {
+        auto start = Clock::now();
+        for (const auto& emp : batch) {
+            if (emp.position == target_position) {
+                local.add(emp.age, emp.salary);
+            }
+        }
+        counters.add_batch(batch.size(), start);
+    }
+
+    std::lock_guard<std::mutex> lock(total_mutex);
+    total.merge(local);
+}
+
+} // namespace
+
+double StageStats::rows_per_second() const {
+    double seconds = stage_seconds();
+    return seconds > 0.0 ? rows / seconds : 0.0;
+}
+
+double PipelineReport::max_stage_seconds() const {
+    double result = 0.0;
+    for (const auto& stage : stages) result = std::max(result, stage.stage_seconds());
+    return result;
+}
+
+double PipelineReport::sum_stage_seconds() const {
+    double result = 0.0;
+    for (const auto& stage : stages) result += stage.stage_seconds();
+    return result;
+}
+
+PipelineReport run_generation_pipeline(size_t rows, const std::string& target_position,
+                                       const PipelineOptions& options, uint32_t seed) {
+    Benchmark wall("Конвейер генерации", false);
+    int producers = std::max(1, options.producers);
+    int aggregators = std::max(1, options.aggregators);
+    size_t batch_rows = std::max<size_t>(1, options.batch_rows);
+    size_t num_batches = (rows + batch_rows - 1) / batch_rows;
+
+    BoundedQueue<RowBatch> batches(options.queue_capacity);
+    StageCounters generate_counters, aggregate_counters;
+    std::atomic<size_t> next_batch{0};
+    std::atomic<int> active_producers{producers};
+    std::mutex total_mutex;
+    DenseAgeHistogram total;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            for (size_t b = next_batch++; b < num_batches; b = next_batch++) {
+                auto start = Clock::now();
+                size_t count = std::min(batch_rows, rows - b * batch_rows);
+                RowBatch batch = generate_employees(static_cast<int>(count), target_position,
+                                                    seed + static_cast<uint32_t>(b));
+                generate_counters.add_batch(count, start);
+                timed_push(batches, std::move(batch), generate_counters);
+            }
+            finish_producer(active_producers, batches);
+        });
+    }
+    for (int a = 0; a < aggregators; ++a) {
+        threads.emplace_back([&]() {
+            aggregate_batches(batches, target_position, aggregate_counters, total_mutex, total);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    PipelineReport report;
+    report.result = answer_from_cells(total.to_map(), 2);
+    report.stages.push_back(generate_counters.snapshot("Генерация", producers));
+    report.stages.push_back(aggregate_counters.snapshot("Агрегация", aggregators));
+    report.wall_seconds = wall.elapsed_seconds();
+    return report;
+}
+
+PipelineReport run_csv_pipeline(const std::string& path, const std::string& target_position,
+                                const PipelineOptions& options) {
+    Benchmark wall("Конвейер CSV", false);
+    PipelineReport report;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Ошибка: не удалось открыть файл " << path << "\n";
+        return report;
+    }
+
+    int parsers = std::max(1, options.producers);
+    int aggregators = std::max(1, options.aggregators);
+    size_t batch_rows = std::max<size_t>(1, options.batch_rows);
+
+    BoundedQueue<TextBlock> blocks(options.queue_capacity);
+    BoundedQueue<RowBatch> batches(options.queue_capacity);
+    StageCounters read_counters, parse_counters, aggregate_counters;
+    std::atomic<int> active_readers{1};
+    std::atomic<int> active_parsers{parsers};
+    std::atomic<size_t> bad_lines{0};
+    std::mutex total_mutex;
+    DenseAgeHistogram total;
+
+    std::vector<std::thread> threads;
+
+    // Чтение большими кусками и нарезка на блоки по batch_rows строк
+    threads.emplace_back([&]() {
+        std::vector<char> chunk(1 << 20);
+        TextBlock block;
+        size_t lines = 0;
+        bool header = true;
+        auto start = Clock::now();
+
+        while (in) {
+            in.read(chunk.data(), chunk.size());
+            size_t got = static_cast<size_t>(in.gcount());
+            const char* p = chunk.data();
+            const char* end = p + got;
+
+            while (p < end) {
+                const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                if (!newline) {
+                    if (!header) block.append(p, end);
+                    break;
+                }
+                if (header) {
+                    header = false;
+                } else {
+                    block.append(p, newline + 1);
+                    if (++lines == batch_rows) {
+                        read_counters.add_batch(lines, start);
+                        timed_push(blocks, std::move(block), read_counters);
+                        block = TextBlock();
+                        lines = 0;
+                        start = Clock::now();
+                    }
+                }
+                p = newline + 1;
+            }
+        }
+
+        if (!block.empty()) {
+            // Последняя строка может быть без перевода строки
+            if (block.back() != '\n') lines++;
+            read_counters.add_batch(lines, start);
+            timed_push(blocks, std::move(block), read_counters);
+        }
+        finish_producer(active_readers, blocks);
+    });
+
+    for (int p = 0; p < parsers; ++p) {
+        threads.emplace_back([&]() {
+            TextBlock block;
+            size_t local_bad = 0;
+            while (timed_pop(blocks, block, parse_counters)) {
+                auto start = Clock::now();
+                RowBatch batch = parse_block(block, local_bad);
+                parse_counters.add_batch(batch.size(), start);
+                timed_push(batches, std::move(batch), parse_counters);
+            }
+            bad_lines += local_bad;
+            finish_producer(active_parsers, batches);
+        });
+    }
+
+    for (int a = 0; a < aggregators; ++a) {
+        threads.emplace_back([&]() {
+            aggregate_batches(batches, target_position, aggregate_counters, total_mutex, total);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    if (bad_lines > 0) {
+        std::cerr << "Предупреждение: пропущено некорректных строк CSV: " << bad_lines << "\n";
+    }
+
+    report.result = answer_from_cells(total.to_map(), 2);
+    report.stages.push_back(read_counters.snapshot("Чтение", 1));
+    report.stages.push_back(parse_counters.snapshot("Разбор", parsers));
+    report.stages.push_back(aggregate_counters.snapshot("Агрегация", aggregators));
+    report.wall_seconds = wall.elapsed_seconds();
+    return report;
+}
+
+bool save_employees_csv(const std::vector<Employee>& employees, const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Ошибка: не удалось создать файл " << path << "\n";
+        return false;
+    }
+
+    out << "name,position,age,salary\n" << std::fixed << std::setprecision(2);
+    for (const auto& emp : employees) {
+        out << emp.name << ',' << emp.position << ',' << emp.age << ',' << emp.salary << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+std::vector<Employee> load_employees_csv(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Ошибка: не удалось открыть файл " << path << "\n";
+        return {};
+    }
+
+    TextBlock text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t header_end = text.find('\n');
+    text.erase(0, header_end == std::string::npos ? text.size() : header_end + 1);
+
+    size_t bad_lines = 0;
+    std::vector<Employee> employees = parse_block(text, bad_lines);
+    if (bad_lines > 0) {
+        std::cerr << "Предупреждение: пропущено некорректных строк CSV: " << bad_lines << "\n";
+    }
+    return employees;
+}
+
+void run_pipeline_benchmark() {
+    std::cout << "\n=== Бенчмарк конвейера: генерация, разбор, агрегация ===\n";
+
+    std::string target_position = "Инженер";
+    const size_t rows = 1000000;
+    const uint32_t seed = 26;
+    const std::string path = "pipeline_employees.csv";
+    int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    PipelineOptions options;
+    options.producers = std::max(1, hardware / 2);
+    options.aggregators = std::max(1, hardware - options.producers);
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    auto print_report = [&](const std::string& title, const PipelineReport& report,
+                            double materialized_seconds) {
+        std::cout << "\n" << title << ":\n";
+        for (const auto& stage : report.stages) {
+            std::cout << "  " << stage.name << " (" << stage.workers << " потоков): "
+                      << stage.batches << " пакетов, "
+                      << std::fixed << std::setprecision(2) << stage.rows_per_second() / 1e6 << " млн строк/с, "
+                      << "работа " << std::setprecision(3) << stage.stage_seconds() << " с, "
+                      << "ожидание места " << stage.blocked_seconds << " с, "
+                      << "простой " << stage.starved_seconds << " с\n";
+        }
+        std::cout << "  Материализация: " << materialized_seconds << " с\n"
+                  << "  Конвейер: " << report.wall_seconds << " с "
+                  << "(сумма стадий " << report.sum_stage_seconds()
+                  << " с, самая медленная " << report.max_stage_seconds() << " с)\n";
+    };
+
+    auto same = [](const QueryResult& a, const QueryResult& b) {
+        return a.count == b.count && a.max_salary == b.max_salary;
+    };
+
+    std::cout << "Строк: " << rows << ", пакет: " << options.batch_rows
+              << ", очередь: " << options.queue_capacity << " пакетов, потоков: "
+              << options.producers << " + " << options.aggregators << "\n";
+
+    // Генерация: весь вектор, затем запрос
+    std::vector<Employee> employees;
+    double generate_seconds, query_seconds;
+    QueryResult materialized;
+    {
+        Benchmark b("Генерация", false);
+        size_t num_batches = (rows + options.batch_rows - 1) / options.batch_rows;
+        employees.reserve(rows);
+        for (size_t k = 0; k < num_batches; ++k) {
+            size_t count = std::min(options.batch_rows, rows - k * options.batch_rows);
+            auto batch = generate_employees(static_cast<int>(count), target_position,
+                                            seed + static_cast<uint32_t>(k));
+            std::move(batch.begin(), batch.end(), std::back_inserter(employees));
+        }
+        generate_seconds = b.elapsed_seconds();
+    }
+    {
+        Benchmark b("Запрос", false);
+        materialized = compute_multi_thread(employees, target_position, hardware);
+        query_seconds = b.elapsed_seconds();
+    }
+
+    PipelineReport generation = run_generation_pipeline(rows, target_position, options, seed);
+    if (!same(generation.result, materialized)) {
+        std::cerr << "Ошибка: конвейер генерации дал другой результат\n";
+    }
+    print_report("Генерация", generation, generate_seconds + query_seconds);
+    benchmark_results.emplace_back("Генерация_материализация", (generate_seconds + query_seconds) * 1e6);
+    benchmark_results.emplace_back("Генерация_конвейер", generation.wall_seconds * 1e6);
+
+    // CSV: загрузка всего файла, затем запрос
+    if (!save_employees_csv(employees, path)) return;
+    employees.clear();
+    employees.shrink_to_fit();
+
+    double load_seconds;
+    {
+        Benchmark b("Загрузка CSV", false);
+        employees = load_employees_csv(path);
+        load_seconds = b.elapsed_seconds();
+    }
+    {
+        Benchmark b("Запрос", false);
+        materialized = compute_multi_thread(employees, target_position, hardware);
+        query_seconds = b.elapsed_seconds();
+    }
+    employees.clear();
+    employees.shrink_to_fit();
+
+    PipelineReport csv = run_csv_pipeline(path, target_position, options);
+    if (!same(csv.result, materialized)) {
+        std::cerr << "Ошибка: конвейер CSV дал другой результат\n";
+    }
+    print_report("CSV", csv, load_seconds + query_seconds);
+    benchmark_results.emplace_back("CSV_материализация", (load_seconds + query_seconds) * 1e6);
+    benchmark_results.emplace_back("CSV_конвейер", csv.wall_seconds * 1e6);
+
+    std::remove(path.c_str());
+    Benchmark::save_to_csv(benchmark_results, "pipeline_benchmark.csv");
+}
+
+} // namespace task2
@@ -0,0 +1,66 @@
+#ifndef TASK2_PIPELINE_H
+#define TASK2_PIPELINE_H
+
+#include "task2_employees.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace task2 {
+
+// Конвейер: стадии-производители (генерация или чтение и разбор CSV)
+// передают пакеты строк агрегаторам через ограниченные очереди без
+// блокировок. Полная очередь притормаживает предыдущую стадию, поэтому
+// в памяти одновременно не больше queue_capacity пакетов на очередь.
+struct PipelineOptions {
+    size_t batch_rows = 4096;     // строк в пакете
+    size_t queue_capacity = 64;   // пакетов в каждой очереди
+    int producers = 1;            // генераторы или разборщики CSV
+    int aggregators = 1;
+};
+
+struct StageStats {
+    std::string name;
+    int workers = 0;
+    uint64_t batches = 0;
+    uint64_t rows = 0;
+    double busy_seconds = 0.0;     // полезная работа, сумма по потокам стадии
+    double blocked_seconds = 0.0;  // ожидание места в выходной очереди
+    double starved_seconds = 0.0;  // ожидание входных пакетов
+
+    // Время стадии, если бы она работала одна своими потоками
+    double stage_seconds() const { return workers > 0 ? busy_seconds / workers : 0.0; }
+    double rows_per_second() const;
+};
+
+struct PipelineReport {
+    QueryResult result;
+    std::vector<StageStats> stages;
+    double wall_seconds = 0.0;
+
+    // Нижняя и верхняя оценки времени: идеальный конвейер упирается в самую
+    // медленную стадию, последовательное выполнение - в их сумму
+    double max_stage_seconds() const;
+    double sum_stage_seconds() const;
+};
+
+// Генерация rows сотрудников пакетами прямо в конвейер. Пакет номер b
+// строится generate_employees(.., seed + b), поэтому данные не зависят от
+// числа потоков.
+PipelineReport run_generation_pipeline(size_t rows, const std::string& target_position,
+                                       const PipelineOptions& options, uint32_t seed = 26);
+
+// Чтение CSV одним потоком, разбор строк producers потоками, агрегация
+PipelineReport run_csv_pipeline(const std::string& path, const std::string& target_position,
+                                const PipelineOptions& options);
+
+// CSV: заголовок "name,position,age,salary" и строка на сотрудника
+bool save_employees_csv(const std::vector<Employee>& employees, const std::string& path);
+std::vector<Employee> load_employees_csv(const std::string& path);
+
+// Бенчмарк: полная материализация против конвейера
+void run_pipeline_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_PIPELINE_H
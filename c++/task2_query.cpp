@@ -0,0 +1,204 @@
+#include "task2_query.h"
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <thread>
+
+namespace task2 {
+
+namespace {
+
+using RowPredicate = std::function<bool(size_t)>;
+using RowValue = std::function<double(size_t)>;
+
+struct ErasedAccumulator {
+    long long count = 0;
+    double sum = 0.0;
+    double max = 0.0;
+
+    void merge(const ErasedAccumulator& other) {
+        count += other.count;
+        sum += other.sum;
+        max = other.max > max ? other.max : max;
+    }
+};
+
+// Число, сумма и максимум value по строкам, где where истинно;
+// каждая строка стоит двух косвенных вызовов
+ErasedAccumulator aggregate_erased(size_t rows, const RowPredicate& where,
+                                   const RowValue& value, ThreadPool& pool) {
+    return pool.parallel_reduce<ErasedAccumulator>(0, rows,
+        [&](size_t begin, size_t end, ErasedAccumulator& acc) {
+            for (size_t i = begin; i < end; ++i) {
+                if (where(i)) {
+                    double v = value(i);
+                    acc.count++;
+                    acc.sum += v;
+                    acc.max = v > acc.max ? v : acc.max;
+                }
+            }
+        });
+}
+
+} // namespace
+
+QueryResult query_expression(const PlainColumns& columns, int position_id, int age_range, ThreadPool& pool) {
+    namespace q = query;
+    QueryResult result;
+
+    auto [count, average_age] = q::select(q::count(), q::avg(q::age()))
+                                    .where(q::position_id() == position_id)
+                                    .run(columns, pool);
+    if (count == 0) return result;
+
+    // Условие |age - avg| <= age_range как целый диапазон: так фильтр
+    // не переходит на double и векторизуется
+    long long lo, hi;
+    age_bounds(average_age, age_range, lo, hi);
+
+    auto [max_salary] = q::select(q::max(q::salary()))
+                            .where(q::position_id() == position_id)
+                            .where(q::between(q::age(), static_cast<int>(lo), static_cast<int>(hi)))
+                            .run(columns, pool);
+
+    result.count = static_cast<int>(count);
+    result.average_age = average_age;
+    result.max_salary = max_salary;
+    return result;
+}
+
+QueryResult query_type_erased(const PlainColumns& columns, int position_id, int age_range, ThreadPool& pool) {
+    QueryResult result;
+
+    auto by_position = aggregate_erased(columns.size(),
+        [&](size_t i) { return columns.position_ids[i] == position_id; },
+        [&](size_t i) { return static_cast<double>(columns.ages[i]); },
+        pool);
+    if (by_position.count == 0) return result;
+
+    double average_age = by_position.sum / by_position.count;
+    auto near_average = aggregate_erased(columns.size(),
+        [&](size_t i) {
+            return columns.position_ids[i] == position_id &&
+                   std::abs(columns.ages[i] - average_age) <= age_range;
+        },
+        [&](size_t i) { return columns.salaries[i]; },
+        pool);
+
+    result.count = static_cast<int>(by_position.count);
+    result.average_age = average_age;
+    result.max_salary = near_average.max;
+    return result;
+}
+
+void run_query_benchmark() {
+    std::cout << "\n=== Бенчмарк запросов на шаблонах выражений ===\n";
+
+    const size_t rows = 10000000;
+    const int num_positions = 8;
+    const int target_position_id = num_positions - 1;
+    const int repeats = 5;
+    int num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+
+    PlainColumns columns = generate_columns(rows, num_positions);
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    std::cout << "Строк: " << rows << ", потоков: " << num_threads << "\n\n";
+
+    auto measure = [&](const std::string& name, auto&& body) {
+        Benchmark b(name, false);
+        for (int r = 0; r < repeats; ++r) {
+            body();
+        }
+        double time = b.elapsed_microseconds() / repeats;
+        std::cout << name << ": " << std::fixed << std::setprecision(2) << time / 1000.0 << " мс\n";
+        benchmark_results.emplace_back(name, time);
+        return time;
+    };
+
+    // Запрос варианта 26
+    std::cout << "Запрос варианта 26 (должность и возраст около среднего):\n";
+    QueryResult hand, expression, erased;
+    double hand_time = measure("  Ручное ядро", [&]() {
+        hand = query_columns(columns, target_position_id, 2, pool);
+    });
+    double expression_time = measure("  Шаблоны выражений", [&]() {
+        expression = query_expression(columns, target_position_id, 2, pool);
+    });
+    double erased_time = measure("  std::function", [&]() {
+        erased = query_type_erased(columns, target_position_id, 2, pool);
+    });
+
+    if (hand.count != expression.count || hand.max_salary != expression.max_salary ||
+        hand.count != erased.count || hand.max_salary != erased.max_salary) {
+        std::cerr << "Ошибка: результаты запроса варианта 26 не совпадают\n";
+    }
+
+    // Произвольный запрос с проекцией: зарплата после вычета 13% налога
+    // у сотрудников 30-39 лет, получающих на руки больше 100 000
+    std::cout << "\nЗапрос с проекцией (зарплата после налога, возраст 30-39):\n";
+    long long generic_count[3] = {};
+    double generic_sum[3] = {}, generic_max[3] = {};
+
+    measure("  Ручной цикл", [&]() {
+        auto acc = pool.parallel_reduce<ErasedAccumulator>(0, rows,
+            [&](size_t begin, size_t end, ErasedAccumulator& local) {
+                long long count = 0;
+                double sum = 0.0, max = local.max;
+                for (size_t i = begin; i < end; ++i) {
+                    double net = columns.salaries[i] * 0.87;
+                    bool match = (columns.ages[i] >= 30) & (columns.ages[i] < 40) & (net > 100000.0);
+                    count += match;
+                    sum += match ? net : 0.0;
+                    max = match && net > max ? net : max;
+                }
+                local.count += count;
+                local.sum += sum;
+                local.max = max;
+            });
+        generic_count[0] = acc.count;
+        generic_sum[0] = acc.sum;
+        generic_max[0] = acc.max;
+    });
+
+    measure("  Шаблоны выражений", [&]() {
+        namespace q = query;
+        auto net = q::salary() * 0.87;
+        auto [count, sum, max] = q::select(q::count(), q::sum(net), q::max(net))
+                                     .where(q::age() >= 30 && q::age() < 40 && net > 100000.0)
+                                     .run(columns, pool);
+        generic_count[1] = count;
+        generic_sum[1] = sum;
+        generic_max[1] = max;
+    });
+
+    measure("  std::function", [&]() {
+        auto acc = aggregate_erased(rows,
+            [&](size_t i) {
+                return columns.ages[i] >= 30 && columns.ages[i] < 40 &&
+                       columns.salaries[i] * 0.87 > 100000.0;
+            },
+            [&](size_t i) { return columns.salaries[i] * 0.87; },
+            pool);
+        generic_count[2] = acc.count;
+        generic_sum[2] = acc.sum;
+        generic_max[2] = acc.max;
+    });
+
+    // Суммы могут отличаться в последних разрядах из-за порядка сложения
+    for (int v = 1; v < 3; ++v) {
+        if (generic_count[v] != generic_count[0] || generic_max[v] != generic_max[0] ||
+            std::abs(generic_sum[v] - generic_sum[0]) > 1e-6 * std::abs(generic_sum[0])) {
+            std::cerr << "Ошибка: результаты запроса с проекцией не совпадают\n";
+        }
+    }
+
+    std::cout << "\n";
+    Benchmark::print_comparison("std::function", erased_time, "Шаблоны выражений", expression_time);
+    Benchmark::print_comparison("Ручное ядро", hand_time, "Шаблоны выражений", expression_time);
+    Benchmark::save_to_csv(benchmark_results, "query_benchmark.csv");
+}
+
+} // namespace task2
@@ -0,0 +1,339 @@
+#ifndef TASK2_QUERY_H
+#define TASK2_QUERY_H
+
+#include "task2_columns.h"
+#include "thread_pool.h"
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace task2 {
+
+// Шаблоны выражений для запросов к столбцам PlainColumns.
+// Каждый узел - небольшой тип-значение с методом eval(c, i), поэтому
+// фильтр, проекции и агрегаты запроса встраиваются в один цикл без
+// косвенных вызовов:
+//
+//   auto [count, avg] = query::select(query::count(), query::avg(query::age()))
+//                           .where(query::position_id() == 3)
+//                           .run(columns, pool);
+namespace query {
+
+struct Expr {};
+
+template <typename T>
+constexpr bool is_expr_v = std::is_base_of_v<Expr, std::decay_t<T>>;
+
+struct PositionColumn : Expr {
+    int eval(const PlainColumns& c, size_t i) const { return c.position_ids[i]; }
+};
+
+struct AgeColumn : Expr {
+    int eval(const PlainColumns& c, size_t i) const { return c.ages[i]; }
+};
+
+struct SalaryColumn : Expr {
+    double eval(const PlainColumns& c, size_t i) const { return c.salaries[i]; }
+};
+
+inline PositionColumn position_id() { return {}; }
+inline AgeColumn age() { return {}; }
+inline SalaryColumn salary() { return {}; }
+
+template <typename T>
+struct Constant : Expr {
+    T value;
+
+    explicit Constant(T v) : value(v) {}
+    T eval(const PlainColumns&, size_t) const { return value; }
+};
+
+// Фильтр по умолчанию: известен на этапе компиляции и исчезает из цикла
+struct AllRows : Expr {
+    bool eval(const PlainColumns&, size_t) const { return true; }
+};
+
+template <typename T>
+auto as_expr(const T& x) {
+    if constexpr (is_expr_v<T>) {
+        return x;
+    } else {
+        static_assert(std::is_arithmetic_v<T>, "В выражении допустимы только числа и узлы query");
+        return Constant<T>(x);
+    }
+}
+
+template <typename T>
+using expr_t = decltype(as_expr(std::declval<T>()));
+
+template <typename E>
+using value_t = decltype(std::declval<const E&>().eval(std::declval<const PlainColumns&>(), size_t{}));
+
+// Логические связки без сокращенного вычисления, чтобы цикл оставался
+// без ветвлений
+struct LogicalAnd {
+    bool operator()(bool a, bool b) const { return a & b; }
+};
+
+struct LogicalOr {
+    bool operator()(bool a, bool b) const { return a | b; }
+};
+
+template <typename Op, typename L, typename R>
+struct Binary : Expr {
+    L lhs;
+    R rhs;
+
+    Binary(L l, R r) : lhs(l), rhs(r) {}
+    auto eval(const PlainColumns& c, size_t i) const { return Op{}(lhs.eval(c, i), rhs.eval(c, i)); }
+};
+
+template <typename E>
+struct Abs : Expr {
+    E arg;
+
+    explicit Abs(E a) : arg(a) {}
+    auto eval(const PlainColumns& c, size_t i) const {
+        auto v = arg.eval(c, i);
+        return v < 0 ? -v : v;
+    }
+};
+
+// lo <= arg <= hi одним узлом; для целых границ сравнение остается целочисленным
+template <typename E, typename T>
+struct Between : Expr {
+    E arg;
+    T lo;
+    T hi;
+
+    Between(E a, T l, T h) : arg(a), lo(l), hi(h) {}
+    bool eval(const PlainColumns& c, size_t i) const {
+        auto v = arg.eval(c, i);
+        return (v >= lo) & (v <= hi);
+    }
+};
+
+template <typename Op, typename L, typename R>
+Binary<Op, expr_t<L>, expr_t<R>> make_binary(const L& l, const R& r) {
+    return {as_expr(l), as_expr(r)};
+}
+
+template <typename L, typename R>
+using enable_if_expr_t = std::enable_if_t<is_expr_v<L> || is_expr_v<R>, int>;
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator+(const L& l, const R& r) { return make_binary<std::plus<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator-(const L& l, const R& r) { return make_binary<std::minus<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator*(const L& l, const R& r) { return make_binary<std::multiplies<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator==(const L& l, const R& r) { return make_binary<std::equal_to<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator!=(const L& l, const R& r) { return make_binary<std::not_equal_to<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator<(const L& l, const R& r) { return make_binary<std::less<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator<=(const L& l, const R& r) { return make_binary<std::less_equal<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator>(const L& l, const R& r) { return make_binary<std::greater<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator>=(const L& l, const R& r) { return make_binary<std::greater_equal<>>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator&&(const L& l, const R& r) { return make_binary<LogicalAnd>(l, r); }
+
+template <typename L, typename R, enable_if_expr_t<L, R> = 0>
+auto operator||(const L& l, const R& r) { return make_binary<LogicalOr>(l, r); }
+
+template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+Abs<E> abs(const E& e) { return Abs<E>(e); }
+
+template <typename E, typename T, std::enable_if_t<is_expr_v<E> && std::is_arithmetic_v<T>, int> = 0>
+Between<E, T> between(const E& e, T lo, T hi) { return Between<E, T>(e, lo, hi); }
+
+// Целые значения суммируются в long long, чтобы не переполниться
+template <typename Value>
+using sum_t = std::conditional_t<std::is_integral_v<Value>, long long, Value>;
+
+// Агрегаты: State накапливается отдельно в каждом исполнителе и
+// объединяется через merge, step получает признак совпадения строки
+struct CountAgg {
+    struct State {
+        long long count = 0;
+        void merge(const State& other) { count += other.count; }
+    };
+
+    void step(State& s, bool match, const PlainColumns&, size_t) const { s.count += match; }
+    long long finish(const State& s) const { return s.count; }
+};
+
+template <typename E>
+struct SumAgg {
+    using Sum = sum_t<value_t<E>>;
+    E arg;
+
+    struct State {
+        Sum sum{};
+        void merge(const State& other) { sum += other.sum; }
+    };
+
+    void step(State& s, bool match, const PlainColumns& c, size_t i) const {
+        Sum v = arg.eval(c, i);
+        s.sum += match ? v : Sum{};
+    }
+    Sum finish(const State& s) const { return s.sum; }
+};
+
+template <typename E>
+struct AvgAgg {
+    using Sum = sum_t<value_t<E>>;
+    E arg;
+
+    struct State {
+        Sum sum{};
+        long long count = 0;
+        void merge(const State& other) {
+            sum += other.sum;
+            count += other.count;
+        }
+    };
+
+    void step(State& s, bool match, const PlainColumns& c, size_t i) const {
+        Sum v = arg.eval(c, i);
+        s.sum += match ? v : Sum{};
+        s.count += match;
+    }
+    double finish(const State& s) const {
+        return s.count > 0 ? static_cast<double>(s.sum) / s.count : 0.0;
+    }
+};
+
+// Без совпадений min и max возвращают Value{}, как find_max_salary_near_average
+template <typename E, typename Better>
+struct ExtremumAgg {
+    using Value = value_t<E>;
+    E arg;
+
+    struct State {
+        Value best = Better{}(Value{1}, Value{0}) ? std::numeric_limits<Value>::lowest()
+                                                  : std::numeric_limits<Value>::max();
+        bool any = false;
+        void merge(const State& other) {
+            best = Better{}(other.best, best) ? other.best : best;
+            any |= other.any;
+        }
+    };
+
+    void step(State& s, bool match, const PlainColumns& c, size_t i) const {
+        Value v = arg.eval(c, i);
+        s.best = match && Better{}(v, s.best) ? v : s.best;
+        s.any |= match;
+    }
+    Value finish(const State& s) const { return s.any ? s.best : Value{}; }
+};
+
+inline CountAgg count() { return {}; }
+
+template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+SumAgg<E> sum(const E& e) { return {e}; }
+
+template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+AvgAgg<E> avg(const E& e) { return {e}; }
+
+template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+ExtremumAgg<E, std::greater<>> max(const E& e) { return {e}; }
+
+template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+ExtremumAgg<E, std::less<>> min(const E& e) { return {e}; }
+
+template <typename... Aggs>
+struct QueryState {
+    std::tuple<typename Aggs::State...> states;
+
+    void merge(const QueryState& other) {
+        merge_all(other, std::index_sequence_for<Aggs...>{});
+    }
+
+private:
+    template <size_t... I>
+    void merge_all(const QueryState& other, std::index_sequence<I...>) {
+        (std::get<I>(states).merge(std::get<I>(other.states)), ...);
+    }
+};
+
+template <typename Pred, typename... Aggs>
+class Query {
+public:
+    Query(Pred where, std::tuple<Aggs...> aggs) : where_(where), aggs_(aggs) {}
+
+    // Повторный where объединяет условия через &&
+    template <typename P>
+    auto where(const P& predicate) const {
+        if constexpr (std::is_same_v<Pred, AllRows>) {
+            return Query<expr_t<P>, Aggs...>(as_expr(predicate), aggs_);
+        } else {
+            auto combined = where_ && as_expr(predicate);
+            return Query<decltype(combined), Aggs...>(combined, aggs_);
+        }
+    }
+
+    // Кортеж результатов агрегатов в порядке select
+    auto run(const PlainColumns& c, ThreadPool& pool) const {
+        auto total = pool.parallel_reduce<QueryState<Aggs...>>(0, c.size(),
+            [&](size_t begin, size_t end, QueryState<Aggs...>& acc) {
+                // Локальная копия состояния держится в регистрах
+                auto states = acc.states;
+                for (size_t i = begin; i < end; ++i) {
+                    bool match = where_.eval(c, i);
+                    step_all(states, match, c, i, std::index_sequence_for<Aggs...>{});
+                }
+                acc.states = states;
+            });
+        return finish_all(total.states, std::index_sequence_for<Aggs...>{});
+    }
+
+private:
+    template <size_t... I>
+    void step_all(std::tuple<typename Aggs::State...>& states, bool match,
+                  const PlainColumns& c, size_t i, std::index_sequence<I...>) const {
+        (std::get<I>(aggs_).step(std::get<I>(states), match, c, i), ...);
+    }
+
+    template <size_t... I>
+    auto finish_all(const std::tuple<typename Aggs::State...>& states, std::index_sequence<I...>) const {
+        return std::make_tuple(std::get<I>(aggs_).finish(std::get<I>(states))...);
+    }
+
+    Pred where_;
+    std::tuple<Aggs...> aggs_;
+};
+
+template <typename... Aggs>
+Query<AllRows, Aggs...> select(const Aggs&... aggs) {
+    return Query<AllRows, Aggs...>(AllRows{}, std::make_tuple(aggs...));
+}
+
+} // namespace query
+
+// Запрос варианта 26, записанный на языке выражений
+QueryResult query_expression(const PlainColumns& columns, int position_id, int age_range, ThreadPool& pool);
+
+// Тот же запрос с фильтром и проекцией через std::function
+QueryResult query_type_erased(const PlainColumns& columns, int position_id, int age_range, ThreadPool& pool);
+
+void run_query_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_QUERY_H
@@ -0,0 +1,416 @@
+#include "task2_shards.h"
+#include "task2_batch.h"
+#include "benchmark_utils.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace task2 {
+
+namespace {
+
+enum ShardCommand { kCommandQuery = 1, kCommandStop = 2 };
+
+// Частичный ответ процесса по его части таблицы
+struct ShardPartial {
+    long long count = 0;
+    long long age_sum = 0;
+    AgeCell cells[kHistogramAges];
+};
+
+// Байт на строку сегмента: должность и возраст int32, зарплата double
+constexpr size_t kShardRowBytes = 2 * sizeof(int32_t) + sizeof(double);
+
+// "0-3,8-11" -> {0, 1, 2, 3, 8, 9, 10, 11}
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t comma = list.find(',', pos);
+        std::string range = list.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        } catch (const std::exception&) {
+            // Пустой или поврежденный фрагмент пропускаем
+        }
+        if (comma == std::string::npos) break;
+        pos = comma + 1;
+    }
+    return cpus;
+}
+
+// Процессоры каждого узла NUMA; без sysfs - один узел со всеми процессорами
+std::vector<std::vector<int>> numa_node_cpus() {
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0; node < 256; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!in) continue;
+        std::string list;
+        std::getline(in, list);
+        std::vector<int> cpus = parse_cpu_list(list);
+        if (!cpus.empty()) nodes.push_back(cpus);
+    }
+
+    if (nodes.empty()) {
+        std::vector<int> all;
+        int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < count; ++cpu) all.push_back(cpu);
+        nodes.push_back(all);
+    }
+    return nodes;
+}
+
+void* map_shared(const std::string& name, size_t bytes) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) return nullptr;
+    void* data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return data == MAP_FAILED ? nullptr : data;
+}
+
+bool create_shared(const std::string& name, size_t bytes) {
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+    bool ok = ftruncate(fd, static_cast<off_t>(std::max<size_t>(bytes, 1))) == 0;
+    close(fd);
+    return ok;
+}
+
+void wait_semaphore(sem_t* sem) {
+    while (sem_wait(sem) != 0 && errno == EINTR) {
+    }
+}
+
+} // namespace
+
+struct ShardedEmployeeTable::Control {
+    sem_t done;
+    int command = 0;
+    int position_id = 0;
+
+    // Слоты процессов на отдельных кэш-линиях
+    struct alignas(kCacheLineSize) Slot {
+        sem_t start;
+        ShardPartial partial;
+    } slots[kMaxShards];
+};
+
+namespace {
+
+// Тело дочернего процесса: закрепление за узлом, заполнение сегмента,
+// цикл обработки команд. Завершается только через _exit, чтобы не
+// выполнять деструкторы и обработчики atexit родителя.
+[[noreturn]] void run_shard_worker(ShardedEmployeeTable::Control* control, int shard,
+                                   const std::string& shard_name, const std::vector<int>& cpus,
+                                   const std::vector<int32_t>& position_ids,
+                                   const std::vector<Employee>& employees, size_t begin, size_t end) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int cpu : cpus) CPU_SET(cpu, &mask);
+    sched_setaffinity(0, sizeof(mask), &mask);
+
+    size_t rows = end - begin;
+    char* data = static_cast<char*>(map_shared(shard_name, std::max<size_t>(rows * kShardRowBytes, 1)));
+    if (!data) _exit(1);
+
+    // Первое обращение к страницам происходит уже на процессорах узла
+    int32_t* shard_positions = reinterpret_cast<int32_t*>(data);
+    int32_t* shard_ages = shard_positions + rows;
+    double* shard_salaries = reinterpret_cast<double*>(shard_ages + rows);
+    for (size_t i = 0; i < rows; ++i) {
+        shard_positions[i] = position_ids[begin + i];
+        shard_ages[i] = employees[begin + i].age;
+        shard_salaries[i] = employees[begin + i].salary;
+    }
+
+    auto& slot = control->slots[shard];
+    sem_post(&control->done);
+
+    for (;;) {
+        wait_semaphore(&slot.start);
+        if (control->command == kCommandStop) {
+            munmap(data, std::max<size_t>(rows * kShardRowBytes, 1));
+            _exit(0);
+        }
+
+        ShardPartial partial;
+        int target = control->position_id;
+        for (size_t i = 0; i < rows; ++i) {
+            if (shard_positions[i] != target) continue;
+            int age = shard_ages[i];
+            partial.count++;
+            partial.age_sum += age;
+            partial.cells[age].add(shard_salaries[i]);
+        }
+        slot.partial = partial;
+        sem_post(&control->done);
+    }
+}
+
+} // namespace
+
+ShardedEmployeeTable::ShardedEmployeeTable(const std::vector<Employee>& employees, int num_shards)
+    : num_shards_(std::clamp(num_shards, 1, kMaxShards)) {
+    static std::atomic<int> table_counter{0};
+
+    // Строки с возрастом вне гистограммы не поместятся в частичный ответ
+    std::vector<int32_t> position_ids(employees.size());
+    for (size_t i = 0; i < employees.size(); ++i) {
+        const Employee& emp = employees[i];
+        if (emp.age < 0 || emp.age >= kHistogramAges) {
+            std::cerr << "Ошибка: возраст " << emp.age << " вне диапазона [0, "
+                      << kHistogramAges << ") для разделенной таблицы\n";
+            return;
+        }
+        auto it = position_ids_.emplace(emp.position, static_cast<int>(position_ids_.size())).first;
+        position_ids[i] = it->second;
+    }
+
+    std::string prefix = "/lab4_" + std::to_string(getpid()) + "_" + std::to_string(table_counter++);
+    control_name_ = prefix + "_ctl";
+    if (!create_shared(control_name_, sizeof(Control))) {
+        std::cerr << "Ошибка: не удалось создать управляющую область " << control_name_ << "\n";
+        control_name_.clear();
+        return;
+    }
+    void* control_memory = map_shared(control_name_, sizeof(Control));
+    if (!control_memory) {
+        std::cerr << "Ошибка: не удалось отобразить управляющую область\n";
+        shutdown();
+        return;
+    }
+    control_ = new (control_memory) Control();
+    sem_init(&control_->done, 1, 0);
+    for (int s = 0; s < num_shards_; ++s) {
+        sem_init(&control_->slots[s].start, 1, 0);
+    }
+
+    std::vector<std::vector<int>> nodes = numa_node_cpus();
+    num_nodes_ = static_cast<int>(nodes.size());
+    size_t shard_rows = (employees.size() + num_shards_ - 1) / num_shards_;
+
+    for (int s = 0; s < num_shards_; ++s) {
+        size_t begin = std::min(employees.size(), s * shard_rows);
+        size_t end = std::min(employees.size(), begin + shard_rows);
+        std::string name = prefix + "_shard" + std::to_string(s);
+
+        // Родитель только задает размер сегмента, страницы не трогает
+        if (!create_shared(name, (end - begin) * kShardRowBytes)) {
+            std::cerr << "Ошибка: не удалось создать сегмент " << name << "\n";
+            shutdown();
+            return;
+        }
+        shard_names_.push_back(name);
+
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Ошибка: не удалось создать процесс для части " << s << "\n";
+            shutdown();
+            return;
+        }
+        if (pid == 0) {
+            run_shard_worker(control_, s, name, nodes[s % nodes.size()], position_ids, employees, begin, end);
+        }
+        workers_.push_back(pid);
+    }
+
+    // Все процессы заполнили свои сегменты
+    if (!wait_for_workers()) {
+        shutdown();
+        return;
+    }
+    valid_ = true;
+}
+
+ShardedEmployeeTable::~ShardedEmployeeTable() {
+    shutdown();
+}
+
+bool ShardedEmployeeTable::wait_for_workers() {
+    for (size_t received = 0; received < workers_.size();) {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += 1;
+
+        if (sem_timedwait(&control_->done, &deadline) == 0) {
+            received++;
+            continue;
+        }
+        if (errno == EINTR) continue;
+
+        // Долго нет ответа: проверяем, живы ли процессы
+        for (pid_t& pid : workers_) {
+            if (pid > 0 && waitpid(pid, nullptr, WNOHANG) == pid) {
+                std::cerr << "Ошибка: процесс части таблицы " << pid << " завершился\n";
+                pid = -1;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void ShardedEmployeeTable::shutdown() {
+    valid_ = false;
+
+    if (control_) {
+        control_->command = kCommandStop;
+        for (size_t s = 0; s < workers_.size(); ++s) {
+            if (workers_[s] > 0) sem_post(&control_->slots[s].start);
+        }
+    }
+    for (pid_t pid : workers_) {
+        if (pid > 0) waitpid(pid, nullptr, 0);
+    }
+    workers_.clear();
+
+    if (control_) {
+        sem_destroy(&control_->done);
+        for (int s = 0; s < num_shards_; ++s) {
+            sem_destroy(&control_->slots[s].start);
+        }
+        control_->~Control();
+        munmap(control_, sizeof(Control));
+        control_ = nullptr;
+    }
+
+    for (const auto& name : shard_names_) {
+        shm_unlink(name.c_str());
+    }
+    shard_names_.clear();
+    if (!control_name_.empty()) {
+        shm_unlink(control_name_.c_str());
+        control_name_.clear();
+    }
+}
+
+QueryResult ShardedEmployeeTable::query(const std::string& target_position, int age_range) {
+    QueryResult result;
+    if (!valid_) return result;
+
+    auto it = position_ids_.find(target_position);
+    if (it == position_ids_.end()) return result;
+
+    control_->command = kCommandQuery;
+    control_->position_id = it->second;
+    for (size_t s = 0; s < workers_.size(); ++s) {
+        sem_post(&control_->slots[s].start);
+    }
+    if (!wait_for_workers()) {
+        shutdown();
+        return result;
+    }
+
+    long long count = 0, age_sum = 0;
+    AgeCell cells[kHistogramAges];
+    for (size_t s = 0; s < workers_.size(); ++s) {
+        const ShardPartial& partial = control_->slots[s].partial;
+        count += partial.count;
+        age_sum += partial.age_sum;
+        for (int age = 0; age < kHistogramAges; ++age) {
+            cells[age].merge(partial.cells[age]);
+        }
+    }
+    if (count == 0) return result;
+
+    result.count = static_cast<int>(count);
+    result.average_age = static_cast<double>(age_sum) / count;
+    for (int age = 0; age < kHistogramAges; ++age) {
+        if (cells[age].count > 0 && std::abs(age - result.average_age) <= age_range &&
+            cells[age].max_salary > result.max_salary) {
+            result.max_salary = cells[age].max_salary;
+        }
+    }
+    return result;
+}
+
+void run_shards_benchmark() {
+    std::cout << "\n=== Бенчмарк процессов с общей памятью ===\n";
+
+    std::string target_position = "Инженер";
+    const int table_size = 2000000;
+    const int repeats = 10;
+    int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<int> counts = {1, 2, 4, hardware};
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+
+    auto employees = generate_employees(table_size, target_position);
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    std::cout << "Сотрудников: " << table_size << ", процессоров: " << hardware << "\n\n";
+    std::cout << std::setw(10) << "N"
+              << std::setw(16) << "Пул (мс)"
+              << std::setw(18) << "Процессы (мс)"
+              << std::setw(20) << "Запуск процессов (мс)"
+              << std::setw(10) << "Узлов" << "\n";
+    std::cout << std::string(74, '-') << std::endl;
+
+    for (int n : counts) {
+        QueryResult in_process, sharded;
+        double pool_time, shard_time, setup_time;
+
+        {
+            Benchmark b("Пул", false);
+            for (int r = 0; r < repeats; ++r) {
+                in_process = compute_multi_thread(employees, target_position, n);
+            }
+            pool_time = b.elapsed_microseconds() / repeats;
+        }
+
+        Benchmark setup("Запуск", false);
+        ShardedEmployeeTable table(employees, n);
+        setup_time = setup.elapsed_microseconds();
+        if (!table.valid()) {
+            std::cerr << "Ошибка: разделенная таблица для " << n << " процессов не создана\n";
+            continue;
+        }
+
+        {
+            Benchmark b("Процессы", false);
+            for (int r = 0; r < repeats; ++r) {
+                sharded = table.query(target_position);
+            }
+            shard_time = b.elapsed_microseconds() / repeats;
+        }
+
+        if (sharded.count != in_process.count || sharded.max_salary != in_process.max_salary) {
+            std::cerr << "Ошибка: результат процессов не совпал с пулом потоков (N = " << n << ")\n";
+        }
+
+        std::cout << std::setw(10) << n
+                  << std::setw(16) << std::fixed << std::setprecision(3) << pool_time / 1000.0
+                  << std::setw(18) << shard_time / 1000.0
+                  << std::setw(20) << setup_time / 1000.0
+                  << std::setw(10) << table.nodes() << "\n";
+
+        benchmark_results.emplace_back(std::to_string(n) + "_пул", pool_time);
+        benchmark_results.emplace_back(std::to_string(n) + "_процессы", shard_time);
+    }
+
+    Benchmark::save_to_csv(benchmark_results, "shards_benchmark.csv");
+}
+
+} // namespace task2
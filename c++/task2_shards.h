@@ -0,0 +1,57 @@
+#ifndef TASK2_SHARDS_H
+#define TASK2_SHARDS_H
+
+#include "task2_employees.h"
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace task2 {
+
+// Таблица, разделенная между дочерними процессами. Каждый процесс
+// закрепляется за процессорами своего узла NUMA (по /sys/devices/system/node)
+// и сам заполняет свой сегмент shm_open, поэтому страницы сегмента
+// размещаются на его узле (first touch). Запрос рассылается через общую
+// управляющую область; процессы возвращают (count, sum_age) и гистограмму
+// "возраст -> число строк, максимальная зарплата" по своей части.
+class ShardedEmployeeTable {
+public:
+    static constexpr int kMaxShards = 64;
+
+    ShardedEmployeeTable(const std::vector<Employee>& employees, int num_shards);
+    ~ShardedEmployeeTable();
+
+    ShardedEmployeeTable(const ShardedEmployeeTable&) = delete;
+    ShardedEmployeeTable& operator=(const ShardedEmployeeTable&) = delete;
+
+    // false - не удалось создать сегменты или процессы
+    bool valid() const { return valid_; }
+    int shards() const { return num_shards_; }
+    int nodes() const { return num_nodes_; }
+
+    QueryResult query(const std::string& target_position, int age_range = 2);
+
+    // Управляющая область в общей памяти: команда, семафоры, частичные ответы
+    struct Control;
+
+private:
+    bool wait_for_workers();
+    void shutdown();
+
+    int num_shards_ = 0;
+    int num_nodes_ = 1;
+    bool valid_ = false;
+    std::unordered_map<std::string, int> position_ids_;
+    std::string control_name_;
+    std::vector<std::string> shard_names_;
+    std::vector<pid_t> workers_;
+    Control* control_ = nullptr;
+};
+
+// Бенчмарк: процессы с общей памятью против пула потоков в одном процессе
+void run_shards_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_SHARDS_H
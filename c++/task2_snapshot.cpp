@@ -0,0 +1,413 @@
+#include "task2_snapshot.h"
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace task2 {
+
+namespace {
+
+// Две фазы запроса по набору кусков столбцов
+QueryResult query_chunks(const std::vector<const ColumnChunk*>& chunks, int position_id, int age_range) {
+    QueryResult result;
+    if (position_id < 0) return result;
+
+    double total_age = 0.0;
+    for (const ColumnChunk* chunk : chunks) {
+        for (size_t i = 0; i < chunk->size(); ++i) {
+            if (chunk->position_ids[i] == position_id) {
+                total_age += chunk->ages[i];
+                result.count++;
+            }
+        }
+    }
+    if (result.count == 0) return result;
+
+    result.average_age = total_age / result.count;
+    for (const ColumnChunk* chunk : chunks) {
+        for (size_t i = 0; i < chunk->size(); ++i) {
+            if (chunk->position_ids[i] == position_id &&
+                std::abs(chunk->ages[i] - result.average_age) <= age_range &&
+                chunk->salaries[i] > result.max_salary) {
+                result.max_salary = chunk->salaries[i];
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int TableSnapshot::position_id(const std::string& position) const {
+    auto it = position_dict->find(position);
+    return it == position_dict->end() ? -1 : it->second;
+}
+
+QueryResult query_snapshot(const TableSnapshot& snapshot,
+                           const std::string& target_position,
+                           int age_range) {
+    std::vector<const ColumnChunk*> chunks;
+    chunks.reserve(snapshot.chunks.size());
+    for (const auto& chunk : snapshot.chunks) {
+        chunks.push_back(chunk.get());
+    }
+    return query_chunks(chunks, snapshot.position_id(target_position), age_range);
+}
+
+SnapshotTable::SnapshotTable(const std::vector<Employee>& employees) {
+    auto* initial = new TableSnapshot();
+    initial->position_dict = std::make_shared<const std::unordered_map<std::string, int>>();
+    current_.store(initial);
+    append(employees);
+}
+
+SnapshotTable::~SnapshotTable() {
+    for (const auto& r : retired_) {
+        delete r.snapshot;
+    }
+    delete current_.load();
+}
+
+SnapshotTable::ReadGuard::ReadGuard(ReadGuard&& other) noexcept
+    : slot_(other.slot_), snapshot_(other.snapshot_) {
+    other.slot_ = nullptr;
+}
+
+SnapshotTable::ReadGuard::~ReadGuard() {
+    if (slot_) {
+        slot_->store(0, std::memory_order_release);
+    }
+}
+
+int SnapshotTable::register_reader() {
+    int reader = reader_count_.fetch_add(1);
+    if (reader >= kMaxReaders) {
+        throw std::runtime_error("SnapshotTable: превышено число читателей");
+    }
+    return reader;
+}
+
+SnapshotTable::ReadGuard SnapshotTable::pin(int reader) const {
+    auto& slot = readers_[reader].epoch;
+
+    // Объявляем эпоху до чтения указателя: писатель, заменивший снимок
+    // после этой записи, увидит нас и не освободит старый снимок.
+    slot.store(global_epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    const TableSnapshot* snapshot = current_.load(std::memory_order_seq_cst);
+    return ReadGuard(&slot, snapshot);
+}
+
+void SnapshotTable::append(const std::vector<Employee>& employees) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+
+    const TableSnapshot* current = current_.load(std::memory_order_acquire);
+    auto* next = new TableSnapshot(*current);
+    next->version = current->version + 1;
+    next->rows = current->rows + employees.size();
+
+    // Неполный последний кусок копируем и дописываем
+    std::shared_ptr<ColumnChunk> tail;
+    if (!next->chunks.empty() && next->chunks.back()->size() < kChunkRows) {
+        tail = std::make_shared<ColumnChunk>(*next->chunks.back());
+        next->chunks.pop_back();
+    }
+
+    // Словарь копируется, только если появилась новая должность
+    std::shared_ptr<std::unordered_map<std::string, int>> dict;
+
+    for (const auto& emp : employees) {
+        const auto& lookup = dict ? *dict : *current->position_dict;
+        auto it = lookup.find(emp.position);
+        int pid;
+        if (it != lookup.end()) {
+            pid = it->second;
+        } else {
+            if (!dict) {
+                dict = std::make_shared<std::unordered_map<std::string, int>>(*current->position_dict);
+            }
+            pid = static_cast<int>(dict->size());
+            dict->emplace(emp.position, pid);
+        }
+
+        if (!tail || tail->size() == kChunkRows) {
+            if (tail) next->chunks.push_back(tail);
+            tail = std::make_shared<ColumnChunk>();
+            tail->position_ids.reserve(kChunkRows);
+            tail->ages.reserve(kChunkRows);
+            tail->salaries.reserve(kChunkRows);
+        }
+
+        tail->position_ids.push_back(pid);
+        tail->ages.push_back(emp.age);
+        tail->salaries.push_back(emp.salary);
+    }
+
+    if (tail) next->chunks.push_back(tail);
+    if (dict) next->position_dict = dict;
+
+    publish(next);
+}
+
+void SnapshotTable::update(size_t row, const Employee& employee) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+
+    const TableSnapshot* current = current_.load(std::memory_order_acquire);
+    if (row >= current->rows) return;
+
+    auto* next = new TableSnapshot(*current);
+    next->version = current->version + 1;
+
+    auto it = current->position_dict->find(employee.position);
+    int pid;
+    if (it != current->position_dict->end()) {
+        pid = it->second;
+    } else {
+        auto dict = std::make_shared<std::unordered_map<std::string, int>>(*current->position_dict);
+        pid = static_cast<int>(dict->size());
+        dict->emplace(employee.position, pid);
+        next->position_dict = dict;
+    }
+
+    // Копируем только затронутый кусок
+    size_t chunk_index = row / kChunkRows;
+    size_t offset = row % kChunkRows;
+    auto chunk = std::make_shared<ColumnChunk>(*current->chunks[chunk_index]);
+    chunk->position_ids[offset] = pid;
+    chunk->ages[offset] = employee.age;
+    chunk->salaries[offset] = employee.salary;
+    next->chunks[chunk_index] = chunk;
+
+    publish(next);
+}
+
+void SnapshotTable::publish(TableSnapshot* next) {
+    const TableSnapshot* old = current_.exchange(next, std::memory_order_seq_cst);
+    uint64_t epoch = global_epoch_.fetch_add(1, std::memory_order_seq_cst);
+    retired_.push_back({old, epoch});
+    reclaim();
+}
+
+void SnapshotTable::reclaim() {
+    // Минимальная эпоха среди активных читателей
+    uint64_t min_active = UINT64_MAX;
+    int readers = std::min(reader_count_.load(), kMaxReaders);
+    for (int i = 0; i < readers; ++i) {
+        uint64_t epoch = readers_[i].epoch.load(std::memory_order_seq_cst);
+        if (epoch != 0 && epoch < min_active) {
+            min_active = epoch;
+        }
+    }
+
+    // Снимок, снятый в эпоху e, мог быть прочитан только читателями с эпохой <= e
+    size_t kept = 0;
+    for (const auto& r : retired_) {
+        if (r.epoch < min_active) {
+            delete r.snapshot;
+        } else {
+            retired_[kept++] = r;
+        }
+    }
+    retired_.resize(kept);
+}
+
+uint64_t SnapshotTable::version() const {
+    return current_.load(std::memory_order_acquire)->version;
+}
+
+size_t SnapshotTable::retired_count() const {
+    return retired_.size();
+}
+
+namespace {
+
+// Базовый вариант: те же столбцы под одной глобальной блокировкой
+struct LockedColumns {
+    std::mutex mtx;
+    ColumnChunk columns;
+    std::unordered_map<std::string, int> position_dict;
+
+    void append(const std::vector<Employee>& employees) {
+        for (const auto& emp : employees) {
+            auto it = position_dict.emplace(emp.position, static_cast<int>(position_dict.size())).first;
+            columns.position_ids.push_back(it->second);
+            columns.ages.push_back(emp.age);
+            columns.salaries.push_back(emp.salary);
+        }
+    }
+
+    void update(size_t row, const Employee& emp) {
+        auto it = position_dict.emplace(emp.position, static_cast<int>(position_dict.size())).first;
+        columns.position_ids[row] = it->second;
+        columns.ages[row] = emp.age;
+        columns.salaries[row] = emp.salary;
+    }
+
+    QueryResult query(const std::string& position, int age_range) {
+        auto it = position_dict.find(position);
+        return query_chunks({&columns}, it == position_dict.end() ? -1 : it->second, age_range);
+    }
+};
+
+struct ConcurrencyStats {
+    double queries_per_second = 0.0;
+    double writer_avg_us = 0.0;
+    double writer_max_us = 0.0;
+    double checksum = 0.0;   // сумма ответов читателей: запросы не выбросит оптимизатор
+};
+
+// Писатель раз в миллисекунду чередует дописывание пачки строк и изменение строки
+template <typename Append, typename Update>
+ConcurrencyStats run_writer_and_readers(int num_readers, int duration_ms,
+                                        const std::vector<std::string>& positions,
+                                        const std::vector<Employee>& batch,
+                                        size_t table_rows,
+                                        Append append, Update update,
+                                        const std::function<QueryResult(int, const std::string&)>& read) {
+    std::atomic<bool> stop{false};
+    std::atomic<long long> total_queries{0};
+    std::vector<double> checksums(num_readers, 0.0);
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < num_readers; ++r) {
+        readers.emplace_back([&, r]() {
+            std::mt19937 gen(r + 1);
+            long long queries = 0;
+            double checksum = 0.0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                QueryResult result = read(r, positions[gen() % positions.size()]);
+                checksum += result.count + result.max_salary;
+                queries++;
+            }
+            total_queries += queries;
+            checksums[r] = checksum;
+        });
+    }
+
+    ConcurrencyStats stats;
+    std::mt19937 gen(26);
+    int operations = 0;
+    double total_latency = 0.0;
+
+    Benchmark wall("Нагрузка", false);
+    while (wall.elapsed_milliseconds() < duration_ms) {
+        Benchmark op("Операция писателя", false);
+        if (operations % 2 == 0) {
+            append(batch);
+        } else {
+            update(gen() % table_rows, batch[gen() % batch.size()]);
+        }
+        double latency = op.elapsed_microseconds();
+
+        total_latency += latency;
+        stats.writer_max_us = std::max(stats.writer_max_us, latency);
+        operations++;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    stop = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    stats.queries_per_second = total_queries.load() / wall.elapsed_seconds();
+    stats.writer_avg_us = operations > 0 ? total_latency / operations : 0.0;
+    for (double checksum : checksums) stats.checksum += checksum;
+    return stats;
+}
+
+} // namespace
+
+void run_snapshot_benchmark() {
+    std::cout << "\n=== Бенчмарк таблицы со снимками (читатели во время записи) ===\n";
+
+    std::string target_position = "Инженер";
+    const int table_size = 100000;
+    const int duration_ms = 300;
+    std::vector<int> reader_counts = {1, 2, 4, 8};
+
+    auto employees = generate_employees(table_size, target_position);
+    auto batch = generate_employees(256, target_position);
+    std::vector<std::string> positions = {"Менеджер", "Разработчик", "Аналитик", target_position};
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    std::cout << std::setw(10) << "Читатели"
+              << std::setw(22) << "Режим"
+              << std::setw(18) << "Запросов/с"
+              << std::setw(22) << "Запись ср. (мкс)"
+              << std::setw(22) << "Запись макс. (мкс)" << "\n";
+    std::cout << std::string(94, '-') << std::endl;
+
+    for (int readers : reader_counts) {
+        ConcurrencyStats locked_stats, snapshot_stats;
+
+        {
+            LockedColumns table;
+            table.append(employees);
+
+            locked_stats = run_writer_and_readers(
+                readers, duration_ms, positions, batch, table_size,
+                [&](const std::vector<Employee>& rows) {
+                    std::lock_guard<std::mutex> lock(table.mtx);
+                    table.append(rows);
+                },
+                [&](size_t row, const Employee& emp) {
+                    std::lock_guard<std::mutex> lock(table.mtx);
+                    table.update(row, emp);
+                },
+                [&](int, const std::string& position) {
+                    std::lock_guard<std::mutex> lock(table.mtx);
+                    return table.query(position, 2);
+                });
+        }
+
+        {
+            SnapshotTable table(employees);
+            std::vector<int> slots;
+            for (int r = 0; r < readers; ++r) {
+                slots.push_back(table.register_reader());
+            }
+
+            snapshot_stats = run_writer_and_readers(
+                readers, duration_ms, positions, batch, table_size,
+                [&](const std::vector<Employee>& rows) { table.append(rows); },
+                [&](size_t row, const Employee& emp) { table.update(row, emp); },
+                [&](int r, const std::string& position) {
+                    auto guard = table.pin(slots[r]);
+                    return query_snapshot(guard.snapshot(), position);
+                });
+        }
+
+        const std::pair<const char*, ConcurrencyStats*> modes[] = {
+            {"Глобальная блокировка", &locked_stats},
+            {"Снимки (RCU)", &snapshot_stats}
+        };
+
+        for (const auto& mode : modes) {
+            std::cout << std::setw(10) << readers
+                      << std::setw(22) << mode.first
+                      << std::setw(18) << std::fixed << std::setprecision(0) << mode.second->queries_per_second
+                      << std::setw(22) << std::fixed << std::setprecision(2) << mode.second->writer_avg_us
+                      << std::setw(22) << std::fixed << std::setprecision(2) << mode.second->writer_max_us << "\n";
+        }
+
+        std::string prefix = std::to_string(readers) + "_читателей_";
+        benchmark_results.emplace_back(prefix + "блокировка_мкс_на_запрос",
+                                       1e6 / std::max(locked_stats.queries_per_second, 1.0));
+        benchmark_results.emplace_back(prefix + "снимки_мкс_на_запрос",
+                                       1e6 / std::max(snapshot_stats.queries_per_second, 1.0));
+        benchmark_results.emplace_back(prefix + "блокировка_запись", locked_stats.writer_avg_us);
+        benchmark_results.emplace_back(prefix + "снимки_запись", snapshot_stats.writer_avg_us);
+    }
+
+    Benchmark::save_to_csv(benchmark_results, "snapshot_benchmark.csv");
+}
+
+} // namespace task2
@@ -0,0 +1,112 @@
+#ifndef TASK2_SNAPSHOT_H
+#define TASK2_SNAPSHOT_H
+
+#include "task2_employees.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace task2 {
+
+// Неизменяемый кусок столбцов таблицы
+struct ColumnChunk {
+    std::vector<int> position_ids;
+    std::vector<int> ages;
+    std::vector<double> salaries;
+
+    size_t size() const { return ages.size(); }
+};
+
+// Согласованный снимок таблицы: набор кусков и словарь должностей.
+// Куски разделяются между снимками и никогда не изменяются.
+struct TableSnapshot {
+    uint64_t version = 0;
+    size_t rows = 0;
+    std::vector<std::shared_ptr<const ColumnChunk>> chunks;
+    std::shared_ptr<const std::unordered_map<std::string, int>> position_dict;
+
+    int position_id(const std::string& position) const;
+};
+
+// Ответ варианта 26 по снимку
+QueryResult query_snapshot(const TableSnapshot& snapshot,
+                           const std::string& target_position,
+                           int age_range = 2);
+
+// Таблица с изоляцией снимков в стиле RCU. Писатель собирает новые куски
+// (копирование при записи) и публикует новый снимок одной атомарной
+// заменой указателя. Читатель закрепляет снимок, записав текущую эпоху в
+// свою ячейку, и не берет никаких блокировок. Старые снимки освобождаются,
+// когда все активные читатели перешли в более позднюю эпоху.
+class SnapshotTable {
+public:
+    static constexpr size_t kChunkRows = 4096;
+    static constexpr int kMaxReaders = 64;
+
+    explicit SnapshotTable(const std::vector<Employee>& employees);
+    ~SnapshotTable();
+
+    SnapshotTable(const SnapshotTable&) = delete;
+    SnapshotTable& operator=(const SnapshotTable&) = delete;
+
+    // Закрепленный снимок; освобождается в деструкторе
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& other) noexcept;
+        ~ReadGuard();
+
+        const TableSnapshot& snapshot() const { return *snapshot_; }
+
+    private:
+        friend class SnapshotTable;
+        ReadGuard(std::atomic<uint64_t>* slot, const TableSnapshot* snapshot)
+            : slot_(slot), snapshot_(snapshot) {}
+
+        std::atomic<uint64_t>* slot_;
+        const TableSnapshot* snapshot_;
+    };
+
+    // Каждый поток-читатель получает свою ячейку эпохи
+    int register_reader();
+    ReadGuard pin(int reader) const;
+
+    // Операции писателя (писатели упорядочены мьютексом)
+    void append(const std::vector<Employee>& employees);
+    void update(size_t row, const Employee& employee);
+
+    uint64_t version() const;
+    size_t retired_count() const;
+
+private:
+    struct alignas(kCacheLineSize) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};   // 0 - читатель не активен
+    };
+
+    struct Retired {
+        const TableSnapshot* snapshot;
+        uint64_t epoch;
+    };
+
+    std::atomic<const TableSnapshot*> current_{nullptr};
+    std::atomic<uint64_t> global_epoch_{1};
+    mutable ReaderSlot readers_[kMaxReaders];
+    std::atomic<int> reader_count_{0};
+
+    std::mutex writer_mutex_;
+    std::vector<Retired> retired_;
+
+    void publish(TableSnapshot* next);
+    void reclaim();
+};
+
+// Бенчмарк: пропускная способность читателей и задержка писателя
+void run_snapshot_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_SNAPSHOT_H
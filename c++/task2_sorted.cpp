@@ -0,0 +1,188 @@
+#include "task2_sorted.h"
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace task2 {
+
+SortedEmployeeTable::SortedEmployeeTable(const EmployeeTable& table) {
+    Benchmark b("Построение упорядоченной раскладки", false);
+
+    const auto& rows = table.rows();
+    const auto& ids = table.position_ids();
+    size_t num_positions = table.positions().size();
+
+    // Упорядочиваем номера строк по (должность, возраст)
+    std::vector<int> order(rows.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        if (ids[a] != ids[b]) return ids[a] < ids[b];
+        return rows[a].age < rows[b].age;
+    });
+
+    position_run_begin_.assign(num_positions, 0);
+    position_run_end_.assign(num_positions, 0);
+    position_count_.assign(num_positions, 0);
+    position_age_sum_.assign(num_positions, 0.0);
+
+    // Сжимаем строки с одинаковыми (должность, возраст) в серии
+    int current_position = -1;
+    for (int row : order) {
+        int pid = ids[row];
+        const auto& emp = rows[row];
+
+        if (pid != current_position) {
+            if (current_position >= 0) {
+                position_run_end_[current_position] = run_ages_.size();
+            }
+            current_position = pid;
+            position_run_begin_[pid] = run_ages_.size();
+        }
+
+        if (run_ages_.size() == position_run_begin_[pid] || run_ages_.back() != emp.age) {
+            run_ages_.push_back(emp.age);
+            run_max_salary_.push_back(emp.salary);
+        } else if (emp.salary > run_max_salary_.back()) {
+            run_max_salary_.back() = emp.salary;
+        }
+
+        position_count_[pid]++;
+        position_age_sum_[pid] += emp.age;
+    }
+    if (current_position >= 0) {
+        position_run_end_[current_position] = run_ages_.size();
+    }
+
+    // Разреженная таблица максимумов
+    sparse_.push_back(run_max_salary_);
+    for (size_t len = 2; len <= run_max_salary_.size(); len *= 2) {
+        const auto& prev = sparse_.back();
+        std::vector<double> level(run_max_salary_.size() - len + 1);
+        for (size_t i = 0; i < level.size(); ++i) {
+            level[i] = std::max(prev[i], prev[i + len / 2]);
+        }
+        sparse_.push_back(std::move(level));
+    }
+
+    build_us_ = b.elapsed_microseconds();
+}
+
+double SortedEmployeeTable::range_max(size_t begin, size_t end) const {
+    if (begin >= end) return 0.0;
+
+    // Два перекрывающихся отрезка длины 2^k покрывают [begin, end)
+    size_t k = 0;
+    while ((size_t(2) << k) <= end - begin) {
+        ++k;
+    }
+    return std::max(sparse_[k][begin], sparse_[k][end - (size_t(1) << k)]);
+}
+
+QueryResult SortedEmployeeTable::query(const EmployeeTable& table, const std::string& target_position,
+                                       int age_range) const {
+    return query(table.position_id(target_position), age_range);
+}
+
+QueryResult SortedEmployeeTable::query(int position_id, int age_range) const {
+    QueryResult result;
+    if (position_id < 0 || position_id >= static_cast<int>(position_count_.size())) {
+        return result;
+    }
+
+    result.count = position_count_[position_id];
+    if (result.count == 0) return result;
+
+    double average_age = position_age_sum_[position_id] / result.count;
+    result.average_age = average_age;
+
+    auto first = run_ages_.begin() + position_run_begin_[position_id];
+    auto last = run_ages_.begin() + position_run_end_[position_id];
+
+    // Те же сравнения, что и в find_max_salary_near_average
+    auto lo = std::partition_point(first, last, [&](int age) {
+        return average_age - age > age_range;
+    });
+    auto hi = std::partition_point(lo, last, [&](int age) {
+        return age - average_age <= age_range;
+    });
+
+    result.max_salary = range_max(lo - run_ages_.begin(), hi - run_ages_.begin());
+    return result;
+}
+
+void run_sorted_benchmark() {
+    std::cout << "\n=== Бенчмарк упорядоченной раскладки (должность, возраст) ===\n";
+
+    std::string target_position = "Инженер";
+    const int table_size = 100000;
+    const int num_queries = 2000;
+
+    auto employees = generate_employees(table_size, target_position);
+    EmployeeTable table(employees);
+    SortedEmployeeTable sorted(table);
+
+    // Запросы со случайной должностью и age_range от 0 до 10
+    std::mt19937 gen(26);
+    std::uniform_int_distribution<> position_dist(0, table.positions().size() - 1);
+    std::uniform_int_distribution<> range_dist(0, 10);
+    std::vector<std::pair<int, int>> queries;
+    for (int q = 0; q < num_queries; ++q) {
+        queries.emplace_back(position_dist(gen), range_dist(gen));
+    }
+
+    double scan_time, index_time, sorted_time;
+    double scan_checksum = 0.0, index_checksum = 0.0, sorted_checksum = 0.0;
+
+    {
+        Benchmark b("Полный просмотр", false);
+        for (const auto& q : queries) {
+            const std::string& position = table.positions()[q.first];
+            double avg = calculate_average_age(employees, position);
+            scan_checksum += find_max_salary_near_average(employees, position, avg, q.second);
+        }
+        scan_time = b.elapsed_microseconds();
+    }
+
+    {
+        Benchmark b("Индекс по должности", false);
+        for (const auto& q : queries) {
+            const std::string& position = table.positions()[q.first];
+            double avg = calculate_average_age(table, position);
+            index_checksum += find_max_salary_near_average(table, position, avg, q.second);
+        }
+        index_time = b.elapsed_microseconds();
+    }
+
+    {
+        Benchmark b("Упорядоченная раскладка", false);
+        for (const auto& q : queries) {
+            sorted_checksum += sorted.query(q.first, q.second).max_salary;
+        }
+        sorted_time = b.elapsed_microseconds();
+    }
+
+    if (scan_checksum != sorted_checksum || index_checksum != sorted_checksum) {
+        std::cerr << "Ошибка: результаты движков не совпадают\n";
+    }
+
+    std::cout << "Строк: " << table_size << ", серий: " << sorted.run_count()
+              << ", запросов: " << num_queries << "\n";
+    std::cout << "Построение раскладки: " << std::fixed << std::setprecision(2)
+              << sorted.build_microseconds() << " мкс\n\n";
+
+    std::vector<std::pair<std::string, double>> benchmark_results = {
+        {"Построение_раскладки", sorted.build_microseconds()},
+        {"Полный_просмотр_" + std::to_string(num_queries) + "_запросов", scan_time},
+        {"Индекс_" + std::to_string(num_queries) + "_запросов", index_time},
+        {"Раскладка_" + std::to_string(num_queries) + "_запросов", sorted_time}
+    };
+
+    Benchmark::print_results(benchmark_results, "Время на все запросы");
+    Benchmark::print_comparison("Полный просмотр", scan_time, "Упорядоченная раскладка", sorted_time);
+    Benchmark::save_to_csv(benchmark_results, "sorted_benchmark.csv");
+}
+
+} // namespace task2
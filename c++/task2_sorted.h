@@ -0,0 +1,50 @@
+#ifndef TASK2_SORTED_H
+#define TASK2_SORTED_H
+
+#include "task2_table.h"
+#include <string>
+#include <vector>
+
+namespace task2 {
+
+// Движок только для чтения: строки упорядочены по (должность, возраст).
+// Строки с одинаковыми должностью и возрастом сжимаются в "серию" с
+// максимальной зарплатой, над сериями строится разреженная таблица.
+// Запрос = O(1) средний возраст + два двоичных поиска + O(1) максимум.
+// Раскладка не хранит ссылку на таблицу: имя должности переводится в номер
+// по таблице, переданной в запрос (той же, по которой она построена).
+class SortedEmployeeTable {
+public:
+    explicit SortedEmployeeTable(const EmployeeTable& table);
+
+    QueryResult query(const EmployeeTable& table, const std::string& target_position,
+                      int age_range = 2) const;
+    QueryResult query(int position_id, int age_range = 2) const;
+
+    size_t run_count() const { return run_ages_.size(); }
+    double build_microseconds() const { return build_us_; }
+
+private:
+    // Серии: возраст и максимальная зарплата, по возрастанию (должность, возраст)
+    std::vector<int> run_ages_;
+    std::vector<double> run_max_salary_;
+
+    // Для каждой должности: диапазон серий, число строк и сумма возрастов
+    std::vector<size_t> position_run_begin_;
+    std::vector<size_t> position_run_end_;
+    std::vector<int> position_count_;
+    std::vector<double> position_age_sum_;
+
+    // sparse_[k][i] = максимум run_max_salary_ на [i, i + 2^k)
+    std::vector<std::vector<double>> sparse_;
+    double build_us_ = 0.0;
+
+    double range_max(size_t begin, size_t end) const;
+};
+
+// Бенчмарк: тысячи запросов с разными должностями и age_range
+void run_sorted_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_SORTED_H
@@ -0,0 +1,338 @@
+#include "task2_stream.h"
+#include "task2_batch.h"
+#include "task2_columns.h"
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace task2 {
+
+namespace {
+
+const char kStreamMagic[8] = {'E', 'M', 'P', 'C', 'O', 'L', '0', '1'};
+constexpr size_t kRowBytes = 2 * sizeof(int32_t) + sizeof(double);
+
+// Текущий VmRSS процесса в килобайтах
+size_t current_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return std::stoul(line.substr(6));
+        }
+    }
+    return 0;
+}
+
+bool read_fully(int fd, char* data, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t n = pread(fd, data, size, offset);
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+bool write_fully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Буфер одного блока; full выставляет читатель, снимает обработчик
+struct ChunkBuffer {
+    std::unique_ptr<char[]> data;
+    size_t rows = 0;
+    bool full = false;
+    bool failed = false;
+};
+
+void fold_chunk(const ChunkBuffer& buffer, int position_id, ThreadPool& pool, DenseAgeHistogram& total) {
+    size_t n = buffer.rows;
+    const int32_t* position_ids = reinterpret_cast<const int32_t*>(buffer.data.get());
+    const int32_t* ages = position_ids + n;
+    const double* salaries = reinterpret_cast<const double*>(ages + n);
+
+    DenseAgeHistogram chunk = pool.parallel_reduce<DenseAgeHistogram>(0, n,
+        [&](size_t begin, size_t end, DenseAgeHistogram& acc) {
+            for (size_t i = begin; i < end; ++i) {
+                if (position_ids[i] == position_id) acc.add(ages[i], salaries[i]);
+            }
+        });
+    total.merge(chunk);
+}
+
+} // namespace
+
+double StreamStats::overlap() const {
+    double shorter = std::min(io_seconds, compute_seconds);
+    if (shorter <= 0.0) return 0.0;
+    double hidden = io_seconds + compute_seconds - wall_seconds;
+    return std::clamp(hidden / shorter, 0.0, 1.0);
+}
+
+bool write_column_file(const std::string& path, size_t rows, int num_positions,
+                       size_t chunk_rows, uint32_t seed) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Ошибка: не удалось создать файл " << path << "\n";
+        return false;
+    }
+
+    StreamFileHeader header;
+    std::memcpy(header.magic, kStreamMagic, sizeof(header.magic));
+    header.rows = rows;
+    header.chunk_rows = chunk_rows;
+    bool ok = write_fully(fd, reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Тот же порядок выборки, что и в generate_columns
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> age_dist(20, 65);
+    std::uniform_real_distribution<> salary_dist(30000, 300000);
+    std::uniform_int_distribution<> position_dist(0, num_positions - 1);
+
+    std::vector<int32_t> position_ids, ages;
+    std::vector<double> salaries;
+    for (size_t start = 0; ok && start < rows; start += chunk_rows) {
+        size_t n = std::min(chunk_rows, rows - start);
+        position_ids.resize(n);
+        ages.resize(n);
+        salaries.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            position_ids[i] = position_dist(gen);
+            ages[i] = age_dist(gen);
+            salaries[i] = std::round(salary_dist(gen) * 100.0) / 100.0;
+        }
+
+        ok = write_fully(fd, reinterpret_cast<const char*>(position_ids.data()), n * sizeof(int32_t)) &&
+             write_fully(fd, reinterpret_cast<const char*>(ages.data()), n * sizeof(int32_t)) &&
+             write_fully(fd, reinterpret_cast<const char*>(salaries.data()), n * sizeof(double));
+    }
+
+    close(fd);
+    if (!ok) {
+        std::cerr << "Ошибка: не удалось записать файл " << path << "\n";
+    }
+    return ok;
+}
+
+QueryResult stream_query(const std::string& path, int position_id, int age_range,
+                         ThreadPool& pool, bool prefetch, StreamStats* stats) {
+    Benchmark wall("Потоковый просмотр", false);
+    StreamStats local_stats;
+    StreamStats& st = stats ? *stats : local_stats;
+    st = StreamStats{};
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Ошибка: не удалось открыть файл " << path << "\n";
+        return QueryResult{};
+    }
+
+    StreamFileHeader header;
+    if (!read_fully(fd, reinterpret_cast<char*>(&header), sizeof(header), 0) ||
+        std::memcmp(header.magic, kStreamMagic, sizeof(header.magic)) != 0 || header.chunk_rows == 0) {
+        std::cerr << "Ошибка: " << path << " не является файлом столбцов\n";
+        close(fd);
+        return QueryResult{};
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    size_t num_chunks = (header.rows + header.chunk_rows - 1) / header.chunk_rows;
+    size_t chunk_bytes = header.chunk_rows * kRowBytes;
+
+    ChunkBuffer buffers[2];
+    for (auto& buffer : buffers) {
+        buffer.data.reset(new char[chunk_bytes]);
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stop = false;
+
+    // Чтение блока k в buffer; после чтения страницы файла отпускаются,
+    // чтобы и кэш страниц не рос вместе с размером таблицы
+    auto load = [&](size_t k, ChunkBuffer& buffer) {
+        size_t rows = std::min<size_t>(header.chunk_rows, header.rows - k * header.chunk_rows);
+        off_t offset = sizeof(header) + static_cast<off_t>(k * chunk_bytes);
+        size_t bytes = rows * kRowBytes;
+
+        Benchmark b("pread", false);
+        bool ok = read_fully(fd, buffer.data.get(), bytes, offset);
+        posix_fadvise(fd, offset, bytes, POSIX_FADV_DONTNEED);
+        double seconds = b.elapsed_seconds();
+
+        std::lock_guard<std::mutex> lock(mtx);
+        st.io_seconds += seconds;
+        st.bytes_read += ok ? bytes : 0;
+        buffer.rows = rows;
+        buffer.failed = !ok;
+        buffer.full = true;
+    };
+
+    std::thread reader;
+    if (prefetch) {
+        reader = std::thread([&]() {
+            for (size_t k = 0; k < num_chunks; ++k) {
+                ChunkBuffer& buffer = buffers[k % 2];
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait(lock, [&]() { return !buffer.full || stop; });
+                    if (stop) return;
+                }
+                load(k, buffer);
+                cv.notify_all();
+                if (buffer.failed) return;
+            }
+        });
+    }
+
+    DenseAgeHistogram total;
+    bool failed = false;
+
+    for (size_t k = 0; k < num_chunks && !failed; ++k) {
+        ChunkBuffer& buffer = buffers[k % 2];
+
+        if (prefetch) {
+            Benchmark b("Ожидание", false);
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [&]() { return buffer.full; });
+            st.wait_seconds += b.elapsed_seconds();
+        } else {
+            load(k, buffer);
+        }
+
+        if (buffer.failed) {
+            std::cerr << "Ошибка чтения блока " << k << " файла " << path << "\n";
+            failed = true;
+            break;
+        }
+
+        {
+            Benchmark b("Обработка", false);
+            fold_chunk(buffer, position_id, pool, total);
+            st.compute_seconds += b.elapsed_seconds();
+        }
+        st.chunks++;
+        st.peak_rss_kb = std::max(st.peak_rss_kb, current_rss_kb());
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            buffer.full = false;
+        }
+        cv.notify_all();
+    }
+
+    if (reader.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stop = true;
+        }
+        cv.notify_all();
+        reader.join();
+    }
+    close(fd);
+    st.wall_seconds = wall.elapsed_seconds();
+
+    if (failed) return QueryResult{};
+
+    return answer_from_cells(total.to_map(), age_range);
+}
+
+void run_stream_benchmark(size_t rows) {
+    std::cout << "\n=== Бенчмарк потокового просмотра таблицы с диска ===\n";
+
+    const int num_positions = 8;
+    const int target_position_id = num_positions - 1;
+    const std::string path = "stream_table.bin";
+    int num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+
+    // Проверка на небольшой таблице, которая помещается в память
+    {
+        const size_t check_rows = 1000000;
+        PlainColumns columns = generate_columns(check_rows, num_positions);
+        QueryResult expected = query_columns(columns, target_position_id, 2, pool);
+        if (write_column_file(path, check_rows, num_positions, 100000)) {
+            QueryResult streamed = stream_query(path, target_position_id, 2, pool);
+            if (streamed.count != expected.count || streamed.max_salary != expected.max_salary) {
+                std::cerr << "Ошибка: потоковый просмотр не совпал с запросом в памяти\n";
+            }
+        }
+    }
+
+    std::cout << "Запись " << rows << " строк ("
+              << std::fixed << std::setprecision(1) << rows * kRowBytes / (1024.0 * 1024.0)
+              << " МБ) в " << path << "...\n";
+    if (!write_column_file(path, rows, num_positions)) return;
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    QueryResult reference;
+
+    std::cout << "\n" << std::setw(14) << "Режим"
+              << std::setw(12) << "Время (с)"
+              << std::setw(12) << "Чтение (с)"
+              << std::setw(14) << "Обработка (с)"
+              << std::setw(14) << "Ожидание (с)"
+              << std::setw(12) << "МБ/с"
+              << std::setw(14) << "Перекрытие"
+              << std::setw(14) << "Пик RSS (МБ)" << "\n";
+    std::cout << std::string(106, '-') << std::endl;
+
+    for (bool prefetch : {false, true}) {
+        // Сбрасываем кэш страниц, чтобы оба режима читали с диска
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+
+        StreamStats st;
+        QueryResult result = stream_query(path, target_position_id, 2, pool, prefetch, &st);
+        std::string name = prefetch ? "Упреждение" : "Синхронно";
+
+        if (!prefetch) {
+            reference = result;
+        } else if (result.count != reference.count || result.max_salary != reference.max_salary) {
+            std::cerr << "Ошибка: режимы чтения дали разные результаты\n";
+        }
+
+        std::cout << std::setw(14) << name
+                  << std::setw(12) << std::fixed << std::setprecision(3) << st.wall_seconds
+                  << std::setw(12) << st.io_seconds
+                  << std::setw(14) << st.compute_seconds
+                  << std::setw(14) << st.wait_seconds
+                  << std::setw(12) << std::setprecision(1) << st.bytes_read / (1024.0 * 1024.0) / st.wall_seconds
+                  << std::setw(13) << st.overlap() * 100 << "%"
+                  << std::setw(14) << st.peak_rss_kb / 1024.0 << "\n";
+
+        benchmark_results.emplace_back(name, st.wall_seconds * 1e6);
+    }
+
+    std::cout << "\nСотрудников: " << reference.count
+              << ", средний возраст: " << std::setprecision(2) << reference.average_age
+              << ", максимальная зарплата: " << reference.max_salary << "\n";
+
+    std::remove(path.c_str());
+    Benchmark::save_to_csv(benchmark_results, "stream_benchmark.csv");
+}
+
+} // namespace task2
@@ -0,0 +1,52 @@
+#ifndef TASK2_STREAM_H
+#define TASK2_STREAM_H
+
+#include "task2_employees.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <string>
+
+namespace task2 {
+
+// Файл таблицы для потокового просмотра: заголовок и блоки по chunk_rows
+// строк, внутри блока столбцы подряд (должность int32, возраст int32,
+// зарплата double), последний блок может быть короче
+struct StreamFileHeader {
+    char magic[8];
+    uint64_t rows;
+    uint64_t chunk_rows;
+};
+
+// Пишет таблицу блоками, не держа ее в памяти целиком; строки совпадают
+// с generate_columns(rows, num_positions, seed)
+bool write_column_file(const std::string& path, size_t rows, int num_positions,
+                       size_t chunk_rows = 1 << 20, uint32_t seed = 26);
+
+struct StreamStats {
+    size_t chunks = 0;
+    size_t bytes_read = 0;
+    double io_seconds = 0.0;       // время внутри pread
+    double compute_seconds = 0.0;  // обработка блоков
+    double wait_seconds = 0.0;     // ожидание данных обработчиком
+    double wall_seconds = 0.0;
+    size_t peak_rss_kb = 0;        // наибольший VmRSS за время просмотра
+
+    // Доля меньшей из фаз (чтение или обработка), скрытая за другой:
+    // 0 - фазы шли последовательно, 1 - полное перекрытие
+    double overlap() const;
+};
+
+// Запрос варианта 26 за один проход по файлу: по каждому возрасту целевой
+// должности копятся число строк и максимальная зарплата, среднее и максимум
+// около среднего получаются после прохода. Память ограничена двумя буферами
+// блока независимо от размера файла. При prefetch = true следующий блок
+// читается отдельным потоком, пока обрабатывается текущий
+QueryResult stream_query(const std::string& path, int position_id, int age_range,
+                         ThreadPool& pool, bool prefetch = true, StreamStats* stats = nullptr);
+
+// Бенчмарк: синхронное чтение против чтения с упреждением
+void run_stream_benchmark(size_t rows = 50000000);
+
+} // namespace task2
+
+#endif // TASK2_STREAM_H
@@ -0,0 +1,524 @@
+#include "task2_table.h"
+#include "benchmark_utils.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+namespace task2 {
+
+// Источник номеров таблиц
+static std::atomic<uint64_t> next_table_id{1};
+
+EmployeeTable::EmployeeTable(std::vector<Employee> employees)
+    : rows_(std::move(employees)), id_(next_table_id.fetch_add(1, std::memory_order_relaxed)) {
+    Benchmark b("Построение индекса", false);
+
+    // Словарь должностей и столбец номеров должностей
+    position_ids_.reserve(rows_.size());
+    for (const auto& emp : rows_) {
+        position_ids_.push_back(intern_position(emp.position));
+    }
+
+    // Списки строк по должностям: сначала считаем размеры, затем заполняем
+    std::vector<size_t> counts(positions_.size(), 0);
+    for (int id : position_ids_) {
+        counts[id]++;
+    }
+
+    for (size_t p = 0; p < positions_.size(); ++p) {
+        rows_by_position_[p].reserve(counts[p]);
+    }
+    for (size_t i = 0; i < position_ids_.size(); ++i) {
+        rows_by_position_[position_ids_[i]].push_back(static_cast<int>(i));
+    }
+
+    // Метаданные блоков
+    zones_.reserve((rows_.size() + kBlockRows - 1) / kBlockRows);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        extend_zone(i);
+    }
+
+    index_build_us_ = b.elapsed_microseconds();
+}
+
+int EmployeeTable::intern_position(const std::string& position) {
+    auto it = position_dict_.find(position);
+    if (it == position_dict_.end()) {
+        it = position_dict_.emplace(position, static_cast<int>(positions_.size())).first;
+        positions_.push_back(position);
+        rows_by_position_.emplace_back();
+    }
+    return it->second;
+}
+
+size_t EmployeeTable::append(const Employee& employee) {
+    size_t row = rows_.size();
+    int pid = intern_position(employee.position);
+
+    rows_.push_back(employee);
+    position_ids_.push_back(pid);
+    rows_by_position_[pid].push_back(static_cast<int>(row));
+    extend_zone(row);
+
+    version_.fetch_add(1, std::memory_order_release);
+    return row;
+}
+
+void EmployeeTable::update(size_t row, const Employee& employee) {
+    int old_pid = position_ids_[row];
+    int new_pid = intern_position(employee.position);
+
+    // При смене должности переносим строку между списками, сохраняя порядок
+    if (old_pid != new_pid) {
+        auto& old_rows = rows_by_position_[old_pid];
+        old_rows.erase(std::lower_bound(old_rows.begin(), old_rows.end(), static_cast<int>(row)));
+
+        auto& new_rows = rows_by_position_[new_pid];
+        new_rows.insert(std::lower_bound(new_rows.begin(), new_rows.end(), static_cast<int>(row)),
+                        static_cast<int>(row));
+        position_ids_[row] = new_pid;
+    }
+
+    rows_[row] = employee;
+    rebuild_zone(row / kBlockRows);
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+namespace {
+
+BlockZone zone_of(const Employee& emp, int position_id) {
+    BlockZone zone;
+    zone.min_age = emp.age;
+    zone.max_age = emp.age;
+    zone.max_salary = emp.salary;
+    zone.position_mask = BlockZone::position_bit(position_id);
+    return zone;
+}
+
+void widen_zone(BlockZone& zone, const Employee& emp, int position_id) {
+    zone.min_age = std::min(zone.min_age, emp.age);
+    zone.max_age = std::max(zone.max_age, emp.age);
+    zone.max_salary = std::max(zone.max_salary, emp.salary);
+    zone.position_mask |= BlockZone::position_bit(position_id);
+}
+
+} // namespace
+
+void ZoneScanStats::merge(const ZoneScanStats& other) {
+    blocks_total += other.blocks_total;
+    blocks_scanned += other.blocks_scanned;
+    skipped_by_position += other.skipped_by_position;
+    skipped_by_age += other.skipped_by_age;
+    skipped_by_salary += other.skipped_by_salary;
+}
+
+void EmployeeTable::extend_zone(size_t row) {
+    size_t block = row / kBlockRows;
+    if (block == zones_.size()) {
+        zones_.push_back(zone_of(rows_[row], position_ids_[row]));
+    } else {
+        widen_zone(zones_[block], rows_[row], position_ids_[row]);
+    }
+}
+
+void EmployeeTable::rebuild_zone(size_t block) {
+    // Изменение строки может уменьшить максимум, поэтому пересчитываем блок
+    size_t begin = block * kBlockRows;
+    size_t end = std::min(begin + kBlockRows, rows_.size());
+
+    BlockZone zone = zone_of(rows_[begin], position_ids_[begin]);
+    for (size_t i = begin + 1; i < end; ++i) {
+        widen_zone(zone, rows_[i], position_ids_[i]);
+    }
+    zones_[block] = zone;
+}
+
+int EmployeeTable::position_id(const std::string& position) const {
+    auto it = position_dict_.find(position);
+    return it == position_dict_.end() ? -1 : it->second;
+}
+
+const std::vector<int>& EmployeeTable::rows_for(const std::string& position) const {
+    return rows_for(position_id(position));
+}
+
+const std::vector<int>& EmployeeTable::rows_for(int position_id) const {
+    static const std::vector<int> empty;
+    if (position_id < 0 || position_id >= static_cast<int>(rows_by_position_.size())) {
+        return empty;
+    }
+    return rows_by_position_[position_id];
+}
+
+double calculate_average_age(const EmployeeTable& table, const std::string& target_position) {
+    const auto& rows = table.rows();
+    const auto& matches = table.rows_for(target_position);
+
+    double total_age = 0.0;
+    for (int row : matches) {
+        total_age += rows[row].age;
+    }
+
+    return matches.empty() ? 0.0 : total_age / matches.size();
+}
+
+double find_max_salary_near_average(const EmployeeTable& table,
+                                   const std::string& target_position,
+                                   double average_age,
+                                   int age_range) {
+    const auto& rows = table.rows();
+    double max_salary = 0.0;
+
+    for (int row : table.rows_for(target_position)) {
+        const auto& emp = rows[row];
+        if (std::abs(emp.age - average_age) <= age_range && emp.salary > max_salary) {
+            max_salary = emp.salary;
+        }
+    }
+
+    return max_salary;
+}
+
+namespace {
+
+enum class BlockVerdict { SCAN, SKIP_POSITION, SKIP_AGE, SKIP_SALARY };
+
+BlockVerdict check_block(const BlockZone& zone, int position_id,
+                         double average_age, int age_range, double best_salary) {
+    if (!zone.may_contain(position_id)) return BlockVerdict::SKIP_POSITION;
+    if (average_age - zone.max_age > age_range || zone.min_age - average_age > age_range) {
+        return BlockVerdict::SKIP_AGE;
+    }
+    if (zone.max_salary <= best_salary) return BlockVerdict::SKIP_SALARY;
+    return BlockVerdict::SCAN;
+}
+
+void count_verdict(ZoneScanStats& stats, BlockVerdict verdict) {
+    stats.blocks_total++;
+    switch (verdict) {
+        case BlockVerdict::SCAN: stats.blocks_scanned++; break;
+        case BlockVerdict::SKIP_POSITION: stats.skipped_by_position++; break;
+        case BlockVerdict::SKIP_AGE: stats.skipped_by_age++; break;
+        case BlockVerdict::SKIP_SALARY: stats.skipped_by_salary++; break;
+    }
+}
+
+// Просмотр блоков [first_block, last_block) второй фазы
+void scan_blocks_for_max(const EmployeeTable& table, int position_id,
+                         double average_age, int age_range,
+                         size_t first_block, size_t last_block,
+                         double& max_salary, ZoneScanStats& stats) {
+    const auto& rows = table.rows();
+    const auto& ids = table.position_ids();
+    const auto& zones = table.zones();
+
+    for (size_t b = first_block; b < last_block; ++b) {
+        BlockVerdict verdict = check_block(zones[b], position_id, average_age, age_range, max_salary);
+        count_verdict(stats, verdict);
+        if (verdict != BlockVerdict::SCAN) continue;
+
+        size_t begin = b * EmployeeTable::kBlockRows;
+        size_t end = std::min(begin + EmployeeTable::kBlockRows, rows.size());
+        for (size_t j = begin; j < end; ++j) {
+            const auto& emp = rows[j];
+            if (ids[j] == position_id &&
+                std::abs(emp.age - average_age) <= age_range &&
+                emp.salary > max_salary) {
+                max_salary = emp.salary;
+            }
+        }
+    }
+}
+
+struct ZoneAgeAccumulator {
+    double total_age = 0.0;
+    int count = 0;
+
+    void merge(const ZoneAgeAccumulator& other) {
+        total_age += other.total_age;
+        count += other.count;
+    }
+};
+
+struct ZoneMaxAccumulator {
+    double max_salary = 0.0;
+    ZoneScanStats stats;
+
+    void merge(const ZoneMaxAccumulator& other) {
+        if (other.max_salary > max_salary) max_salary = other.max_salary;
+        stats.merge(other.stats);
+    }
+};
+
+} // namespace
+
+double find_max_salary_near_average(const EmployeeTable& table,
+                                   const std::string& target_position,
+                                   double average_age,
+                                   int age_range,
+                                   ZoneScanStats& stats) {
+    double max_salary = 0.0;
+    scan_blocks_for_max(table, table.position_id(target_position), average_age, age_range,
+                        0, table.zones().size(), max_salary, stats);
+    return max_salary;
+}
+
+QueryResult compute_multi_thread(const EmployeeTable& table,
+                                 const std::string& target_position,
+                                 int num_threads,
+                                 int age_range,
+                                 ZoneScanStats* stats) {
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+    const auto& rows = table.rows();
+    const auto& ids = table.position_ids();
+    const auto& zones = table.zones();
+    int position_id = table.position_id(target_position);
+
+    // Куски выровнены по границам блоков
+    const size_t block = EmployeeTable::kBlockRows;
+    size_t blocks_per_chunk = std::max<size_t>(1, zones.size() / (pool.size() * ThreadPool::kChunksPerWorker));
+    size_t grain = blocks_per_chunk * block;
+
+    // Первая фаза: блоки без должности пропускаются по битовой маске
+    ZoneAgeAccumulator sum = pool.parallel_reduce<ZoneAgeAccumulator>(
+        0, rows.size(),
+        [&](size_t begin, size_t end, ZoneAgeAccumulator& acc) {
+            for (size_t b = begin / block; b * block < end; ++b) {
+                if (!zones[b].may_contain(position_id)) continue;
+                size_t last = std::min(end, (b + 1) * block);
+                for (size_t j = b * block; j < last; ++j) {
+                    if (ids[j] == position_id) {
+                        acc.total_age += rows[j].age;
+                        acc.count++;
+                    }
+                }
+            }
+        }, grain);
+
+    QueryResult result;
+    result.count = sum.count;
+    result.average_age = sum.count > 0 ? sum.total_age / sum.count : 0.0;
+    double average_age = result.average_age;
+
+    // Вторая фаза: у каждого исполнителя свой текущий максимум для отсечения
+    ZoneMaxAccumulator best = pool.parallel_reduce<ZoneMaxAccumulator>(
+        0, rows.size(),
+        [&](size_t begin, size_t end, ZoneMaxAccumulator& acc) {
+            size_t first_block = begin / block;
+            size_t last_block = (end + block - 1) / block;
+            scan_blocks_for_max(table, position_id, average_age, age_range,
+                                first_block, last_block, acc.max_salary, acc.stats);
+        }, grain);
+
+    result.max_salary = best.max_salary;
+    if (stats) stats->merge(best.stats);
+    return result;
+}
+
+void process_multi_thread(const EmployeeTable& table,
+                         const std::string& target_position,
+                         int num_threads) {
+    if (table.size() == 0) {
+        std::cout << "Нет данных для обработки\n";
+        return;
+    }
+
+    ZoneScanStats stats;
+    QueryResult result = compute_multi_thread(table, target_position, num_threads, 2, &stats);
+
+    std::cout << "\n=== Результаты обработки (многопоточная, с метаданными блоков) ===\n";
+    std::cout << "Использовано потоков: " << num_threads << "\n";
+    std::cout << "Всего сотрудников: " << table.size() << "\n";
+    std::cout << "Сотрудников с должностью '" << target_position << "': " << result.count << "\n";
+    std::cout << "Блоков во второй фазе: " << stats.blocks_total
+              << ", просмотрено: " << stats.blocks_scanned
+              << ", пропущено: " << stats.blocks_skipped() << "\n\n";
+
+    if (result.count > 0) {
+        std::cout << "Средний возраст: " << std::fixed << std::setprecision(2) << result.average_age << " лет\n";
+        std::cout << "Максимальная зарплата среди сотрудников\n";
+        std::cout << "с возрастом ±2 года от среднего: "
+                  << std::fixed << std::setprecision(2) << result.max_salary << " руб.\n";
+    } else {
+        std::cout << "Нет сотрудников с должностью '" << target_position << "'\n";
+    }
+}
+
+QueryResult compute_indexed(const EmployeeTable& table,
+                            const std::string& target_position,
+                            int age_range) {
+    QueryResult result;
+    result.count = static_cast<int>(table.rows_for(target_position).size());
+    result.average_age = calculate_average_age(table, target_position);
+    result.max_salary = find_max_salary_near_average(table, target_position,
+                                                     result.average_age, age_range);
+    return result;
+}
+
+void run_index_benchmark() {
+    std::cout << "\n=== Бенчмарк индекса по должности ===\n";
+
+    std::string target_position = "Инженер";
+    std::vector<int> test_sizes = {10000, 100000, 1000000};
+    const int queries = 20;
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    std::cout << std::setw(10) << "Размер"
+              << std::setw(18) << "Индекс (мкс)"
+              << std::setw(18) << "Полный (мкс)"
+              << std::setw(20) << "По индексу (мкс)"
+              << std::setw(15) << "Ускорение" << "\n";
+    std::cout << std::string(81, '-') << std::endl;
+
+    for (int size : test_sizes) {
+        auto employees = generate_employees(size, target_position);
+        EmployeeTable table(employees);
+
+        double scan_time, index_time;
+        double scan_checksum = 0.0, index_checksum = 0.0;
+
+        {
+            Benchmark b("Полный просмотр", false);
+            for (int q = 0; q < queries; ++q) {
+                double avg = calculate_average_age(employees, target_position);
+                scan_checksum += find_max_salary_near_average(employees, target_position, avg);
+            }
+            scan_time = b.elapsed_microseconds() / queries;
+        }
+
+        {
+            Benchmark b("По индексу", false);
+            for (int q = 0; q < queries; ++q) {
+                double avg = calculate_average_age(table, target_position);
+                index_checksum += find_max_salary_near_average(table, target_position, avg);
+            }
+            index_time = b.elapsed_microseconds() / queries;
+        }
+
+        if (scan_checksum != index_checksum) {
+            std::cerr << "Ошибка: результаты по индексу не совпадают с полным просмотром\n";
+        }
+
+        double speedup = index_time > 0 ? scan_time / index_time : 0.0;
+        std::string prefix = std::to_string(size) + "_сотр_";
+        benchmark_results.emplace_back(prefix + "построение_индекса", table.index_build_microseconds());
+        benchmark_results.emplace_back(prefix + "полный_просмотр", scan_time);
+        benchmark_results.emplace_back(prefix + "по_индексу", index_time);
+
+        std::cout << std::setw(10) << size
+                  << std::setw(18) << std::fixed << std::setprecision(2) << table.index_build_microseconds()
+                  << std::setw(18) << std::fixed << std::setprecision(2) << scan_time
+                  << std::setw(20) << std::fixed << std::setprecision(2) << index_time
+                  << std::setw(14) << std::fixed << std::setprecision(2) << speedup << "x\n";
+    }
+
+    Benchmark::save_to_csv(benchmark_results, "index_benchmark.csv");
+}
+
+void run_zone_map_benchmark() {
+    std::cout << "\n=== Бенчмарк метаданных блоков (zone maps) ===\n";
+
+    std::string target_position = "Инженер";
+    const int table_size = 1000000;
+    const int num_threads = 4;
+    const int repeats = 10;
+
+    auto generated = generate_employees(table_size, target_position);
+
+    // Один и тот же набор строк в трех порядках
+    auto by_position = generated;
+    std::stable_sort(by_position.begin(), by_position.end(),
+                     [](const Employee& a, const Employee& b) { return a.position < b.position; });
+    auto by_position_age = by_position;
+    std::stable_sort(by_position_age.begin(), by_position_age.end(),
+                     [](const Employee& a, const Employee& b) { return a.age < b.age; });
+    std::stable_sort(by_position_age.begin(), by_position_age.end(),
+                     [](const Employee& a, const Employee& b) { return a.position < b.position; });
+
+    const std::pair<const char*, std::vector<Employee>*> layouts[] = {
+        {"случайный", &generated},
+        {"по_должности", &by_position},
+        {"по_должности_и_возрасту", &by_position_age}
+    };
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    for (const auto& layout : layouts) {
+        const auto& employees = *layout.second;
+        EmployeeTable table(employees);
+        double average_age = calculate_average_age(employees, target_position);
+
+        double scan_time, zoned_time, multi_time, multi_zoned_time;
+        double scan_max = 0.0, zoned_max = 0.0;
+        ZoneScanStats stats;
+        QueryResult multi, multi_zoned;
+        ZoneScanStats multi_stats;
+
+        {
+            Benchmark b("Полный просмотр", false);
+            for (int r = 0; r < repeats; ++r) {
+                scan_max = find_max_salary_near_average(employees, target_position, average_age);
+            }
+            scan_time = b.elapsed_microseconds() / repeats;
+        }
+
+        {
+            Benchmark b("С пропуском блоков", false);
+            for (int r = 0; r < repeats; ++r) {
+                stats = ZoneScanStats{};
+                zoned_max = find_max_salary_near_average(table, target_position, average_age, 2, stats);
+            }
+            zoned_time = b.elapsed_microseconds() / repeats;
+        }
+
+        {
+            Benchmark b("Многопоточная", false);
+            for (int r = 0; r < repeats; ++r) {
+                multi = compute_multi_thread(employees, target_position, num_threads);
+            }
+            multi_time = b.elapsed_microseconds() / repeats;
+        }
+
+        {
+            Benchmark b("Многопоточная с пропуском", false);
+            for (int r = 0; r < repeats; ++r) {
+                multi_stats = ZoneScanStats{};
+                multi_zoned = compute_multi_thread(table, target_position, num_threads, 2, &multi_stats);
+            }
+            multi_zoned_time = b.elapsed_microseconds() / repeats;
+        }
+
+        if (scan_max != zoned_max || multi.max_salary != multi_zoned.max_salary || scan_max != multi.max_salary) {
+            std::cerr << "Ошибка: результат с пропуском блоков не совпадает с полным просмотром\n";
+        }
+
+        std::cout << "\nПорядок строк: " << layout.first << "\n";
+        std::cout << "  Однопоточно: блоков " << stats.blocks_total
+                  << ", просмотрено " << stats.blocks_scanned
+                  << ", пропущено " << stats.blocks_skipped()
+                  << " (должность: " << stats.skipped_by_position
+                  << ", возраст: " << stats.skipped_by_age
+                  << ", зарплата: " << stats.skipped_by_salary << ")\n";
+        std::cout << "  " << num_threads << " потока: блоков " << multi_stats.blocks_total
+                  << ", просмотрено " << multi_stats.blocks_scanned
+                  << ", пропущено " << multi_stats.blocks_skipped() << "\n";
+        std::cout << "  Вторая фаза: " << std::fixed << std::setprecision(2)
+                  << scan_time << " мкс -> " << zoned_time << " мкс\n";
+        std::cout << "  Многопоточная обработка: "
+                  << multi_time << " мкс -> " << multi_zoned_time << " мкс\n";
+
+        std::string prefix = std::string(layout.first) + "_";
+        benchmark_results.emplace_back(prefix + "вторая_фаза_полный", scan_time);
+        benchmark_results.emplace_back(prefix + "вторая_фаза_блоки", zoned_time);
+        benchmark_results.emplace_back(prefix + "многопоточная_полный", multi_time);
+        benchmark_results.emplace_back(prefix + "многопоточная_блоки", multi_zoned_time);
+    }
+
+    Benchmark::save_to_csv(benchmark_results, "zone_map_benchmark.csv");
+}
+
+} // namespace task2
@@ -0,0 +1,137 @@
+#ifndef TASK2_TABLE_H
+#define TASK2_TABLE_H
+
+#include "task2_employees.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace task2 {
+
+// Метаданные блока строк (zone map): диапазон возрастов, максимальная
+// зарплата и битовая маска присутствующих должностей. Должности с номером
+// 63 и выше делят последний бит маски.
+struct BlockZone {
+    int min_age = 0;
+    int max_age = 0;
+    double max_salary = 0.0;
+    uint64_t position_mask = 0;
+
+    static uint64_t position_bit(int position_id) {
+        return uint64_t(1) << (position_id < 63 ? position_id : 63);
+    }
+
+    bool may_contain(int position_id) const {
+        return position_id >= 0 && (position_mask & position_bit(position_id)) != 0;
+    }
+};
+
+// Сколько блоков просмотрено и сколько пропущено (и по какой причине)
+struct ZoneScanStats {
+    size_t blocks_total = 0;
+    size_t blocks_scanned = 0;
+    size_t skipped_by_position = 0;
+    size_t skipped_by_age = 0;
+    size_t skipped_by_salary = 0;
+
+    void merge(const ZoneScanStats& other);
+    size_t blocks_skipped() const {
+        return skipped_by_position + skipped_by_age + skipped_by_salary;
+    }
+};
+
+// Таблица сотрудников со словарем должностей и индексом
+// "должность -> номера строк", который строится при загрузке.
+class EmployeeTable {
+public:
+    explicit EmployeeTable(std::vector<Employee> employees);
+
+    const std::vector<Employee>& rows() const { return rows_; }
+    size_t size() const { return rows_.size(); }
+
+    // Номер должности в словаре или -1, если такой должности нет
+    int position_id(const std::string& position) const;
+    const std::vector<std::string>& positions() const { return positions_; }
+
+    // Номер должности для каждой строки
+    const std::vector<int>& position_ids() const { return position_ids_; }
+
+    // Номера строк с заданной должностью (по возрастанию)
+    const std::vector<int>& rows_for(const std::string& position) const;
+    const std::vector<int>& rows_for(int position_id) const;
+
+    // Метаданные блоков по kBlockRows строк
+    static constexpr size_t kBlockRows = 4096;
+    const std::vector<BlockZone>& zones() const { return zones_; }
+
+    // Изменения таблицы поддерживают индекс, метаданные блоков и увеличивают номер версии.
+    // Версию читают конкурентные читатели (кэш запросов), поэтому она атомарная
+    size_t append(const Employee& employee);
+    void update(size_t row, const Employee& employee);
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+    // Номер таблицы, уникальный в пределах процесса: версии разных таблиц
+    // начинаются с 0, поэтому кэш различает таблицы по нему
+    uint64_t id() const { return id_; }
+
+    // Время построения словаря и индекса
+    double index_build_microseconds() const { return index_build_us_; }
+
+private:
+    std::vector<Employee> rows_;
+    std::unordered_map<std::string, int> position_dict_;
+    std::vector<std::string> positions_;
+    std::vector<int> position_ids_;
+    std::vector<std::vector<int>> rows_by_position_;
+    double index_build_us_ = 0.0;
+    std::vector<BlockZone> zones_;
+    std::atomic<uint64_t> version_{0};
+    uint64_t id_;
+
+    int intern_position(const std::string& position);
+    void extend_zone(size_t row);
+    void rebuild_zone(size_t block);
+};
+
+// Запросы по индексу: просматриваются только строки с нужной должностью
+double calculate_average_age(const EmployeeTable& table, const std::string& target_position);
+double find_max_salary_near_average(const EmployeeTable& table,
+                                   const std::string& target_position,
+                                   double average_age,
+                                   int age_range = 2);
+
+// Вторая фаза с пропуском блоков по метаданным: блок не просматривается,
+// если в нем нет должности, нет подходящих возрастов или его максимальная
+// зарплата не превышает уже найденную.
+double find_max_salary_near_average(const EmployeeTable& table,
+                                   const std::string& target_position,
+                                   double average_age,
+                                   int age_range,
+                                   ZoneScanStats& stats);
+
+// Многопоточная обработка таблицы с пропуском блоков
+QueryResult compute_multi_thread(const EmployeeTable& table,
+                                 const std::string& target_position,
+                                 int num_threads,
+                                 int age_range = 2,
+                                 ZoneScanStats* stats = nullptr);
+void process_multi_thread(const EmployeeTable& table,
+                         const std::string& target_position,
+                         int num_threads);
+
+// Полный ответ варианта 26 по индексу
+QueryResult compute_indexed(const EmployeeTable& table,
+                            const std::string& target_position,
+                            int age_range = 2);
+
+// Бенчмарк: стоимость построения индекса и ускорение запросов
+void run_index_benchmark();
+
+// Бенчмарк: пропущенные и просмотренные блоки при разных порядках строк
+void run_zone_map_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_TABLE_H
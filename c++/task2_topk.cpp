@@ -0,0 +1,392 @@
+#include "task2_topk.h"
+#include "benchmark_utils.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <queue>
+
+namespace task2 {
+
+namespace {
+
+// Кандидат: зарплата и номер строки; при равной зарплате выше меньший номер
+using Candidate = std::pair<double, size_t>;
+
+bool better(const Candidate& a, const Candidate& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+struct TopKAccumulator {
+    // Куча с худшим кандидатом на вершине
+    std::vector<Candidate> heap;
+    // Кучи других исполнителей, собранные при древовидном объединении
+    std::vector<std::vector<Candidate>> runs;
+
+    void offer(const Candidate& candidate, size_t k) {
+        if (heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end(), better);
+        } else if (better(candidate, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+
+    void merge(const TopKAccumulator& other) {
+        if (!other.heap.empty()) runs.push_back(other.heap);
+        runs.insert(runs.end(), other.runs.begin(), other.runs.end());
+    }
+};
+
+// Гистограмма возрастов: плотная часть для 0..127 и таблица для остальных
+struct AgeCountAccumulator {
+    static constexpr int kDenseAges = 128;
+    std::vector<long long> dense;
+    std::map<int, long long> overflow;
+
+    void add(int age) {
+        if (dense.empty()) dense.assign(kDenseAges, 0);
+        if (age >= 0 && age < kDenseAges) {
+            dense[age]++;
+        } else {
+            overflow[age]++;
+        }
+    }
+
+    void merge(const AgeCountAccumulator& other) {
+        if (!other.dense.empty()) {
+            if (dense.empty()) dense.assign(kDenseAges, 0);
+            for (int a = 0; a < kDenseAges; ++a) dense[a] += other.dense[a];
+        }
+        for (const auto& [age, count] : other.overflow) overflow[age] += count;
+    }
+};
+
+struct SketchAccumulator {
+    QuantileSketch sketch;
+
+    void merge(const SketchAccumulator& other) { sketch.merge(other.sketch); }
+};
+
+// Номер элемента (с единицы) для квантиля q из n элементов
+size_t quantile_rank(double q, size_t n) {
+    size_t rank = static_cast<size_t>(std::ceil(q * n));
+    return std::min(std::max<size_t>(rank, 1), n);
+}
+
+} // namespace
+
+std::vector<Employee> top_k_near_average(const std::vector<Employee>& employees,
+                                         const std::string& target_position,
+                                         size_t k,
+                                         int num_threads,
+                                         int age_range) {
+    std::vector<Employee> top;
+    if (k == 0) return top;
+
+    double average_age = compute_multi_thread(employees, target_position, num_threads, age_range).average_age;
+
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+    TopKAccumulator acc = pool.parallel_reduce<TopKAccumulator>(
+        0, employees.size(),
+        [&](size_t begin, size_t end, TopKAccumulator& local) {
+            for (size_t j = begin; j < end; ++j) {
+                const auto& emp = employees[j];
+                if (emp.position == target_position &&
+                    std::abs(emp.age - average_age) <= age_range) {
+                    local.offer({emp.salary, j}, k);
+                }
+            }
+        });
+
+    // k-путевое слияние упорядоченных куч исполнителей
+    acc.runs.push_back(std::move(acc.heap));
+    for (auto& run : acc.runs) {
+        std::sort(run.begin(), run.end(), better);
+    }
+
+    // Элемент очереди: (кандидат, номер кучи, позиция в куче); сверху лучший
+    using Head = std::pair<Candidate, std::pair<size_t, size_t>>;
+    auto worse_head = [](const Head& a, const Head& b) { return better(b.first, a.first); };
+    std::priority_queue<Head, std::vector<Head>, decltype(worse_head)> heads(worse_head);
+
+    for (size_t r = 0; r < acc.runs.size(); ++r) {
+        if (!acc.runs[r].empty()) heads.push({acc.runs[r][0], {r, 0}});
+    }
+
+    while (!heads.empty() && top.size() < k) {
+        Head head = heads.top();
+        heads.pop();
+        top.push_back(employees[head.first.second]);
+
+        size_t r = head.second.first, next = head.second.second + 1;
+        if (next < acc.runs[r].size()) heads.push({acc.runs[r][next], {r, next}});
+    }
+
+    return top;
+}
+
+std::vector<int> exact_age_quantiles(const std::vector<Employee>& employees,
+                                     const std::string& target_position,
+                                     const std::vector<double>& quantiles,
+                                     int num_threads) {
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+    AgeCountAccumulator acc = pool.parallel_reduce<AgeCountAccumulator>(
+        0, employees.size(),
+        [&](size_t begin, size_t end, AgeCountAccumulator& local) {
+            for (size_t j = begin; j < end; ++j) {
+                if (employees[j].position == target_position) {
+                    local.add(employees[j].age);
+                }
+            }
+        });
+
+    // Частоты по возрастанию возраста
+    std::map<int, long long> counts = acc.overflow;
+    for (int a = 0; a < static_cast<int>(acc.dense.size()); ++a) {
+        if (acc.dense[a] > 0) counts[a] += acc.dense[a];
+    }
+
+    size_t n = 0;
+    for (const auto& entry : counts) n += entry.second;
+
+    std::vector<int> result;
+    for (double q : quantiles) {
+        if (n == 0) {
+            result.push_back(0);
+            continue;
+        }
+        size_t rank = quantile_rank(q, n);
+        size_t cumulative = 0;
+        for (const auto& [age, count] : counts) {
+            cumulative += count;
+            if (cumulative >= rank) {
+                result.push_back(age);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+QuantileSketch::QuantileSketch(int k)
+    : k_(k < 8 ? 8 : k), levels_(1), gen_(26) {}
+
+size_t QuantileSketch::level_capacity(size_t level) const {
+    // Верхние уровни вмещают k элементов, нижние - геометрически меньше
+    size_t depth = levels_.size() - 1 - level;
+    double capacity = k_ * std::pow(2.0 / 3.0, static_cast<double>(depth));
+    return std::max<size_t>(8, static_cast<size_t>(std::ceil(capacity)));
+}
+
+size_t QuantileSketch::retained() const {
+    size_t total = 0;
+    for (const auto& level : levels_) total += level.size();
+    return total;
+}
+
+void QuantileSketch::add(double value) {
+    levels_[0].push_back(value);
+    count_++;
+    if (levels_[0].size() >= level_capacity(0)) {
+        compress();
+    }
+}
+
+void QuantileSketch::compress() {
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        if (levels_[h].size() < level_capacity(h)) continue;
+
+        if (h + 1 == levels_.size()) levels_.emplace_back();
+
+        // Сжатие уровня: после сортировки каждый второй элемент (со случайным
+        // смещением) переходит на следующий уровень с удвоенным весом
+        auto& level = levels_[h];
+        std::sort(level.begin(), level.end());
+
+        double leftover = 0.0;
+        bool has_leftover = level.size() % 2 == 1;
+        if (has_leftover) {
+            leftover = level.back();
+            level.pop_back();
+        }
+
+        size_t offset = gen_() % 2;
+        for (size_t i = offset; i < level.size(); i += 2) {
+            levels_[h + 1].push_back(level[i]);
+        }
+
+        level.clear();
+        if (has_leftover) level.push_back(leftover);
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.levels_.size() > levels_.size()) {
+        levels_.resize(other.levels_.size());
+    }
+    for (size_t h = 0; h < other.levels_.size(); ++h) {
+        levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+    }
+    count_ += other.count_;
+    compress();
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (count_ == 0) return 0.0;
+
+    std::vector<std::pair<double, size_t>> weighted;
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        for (double value : levels_[h]) {
+            weighted.emplace_back(value, size_t(1) << h);
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    size_t total = 0;
+    for (const auto& item : weighted) total += item.second;
+
+    size_t rank = quantile_rank(q, total);
+    size_t cumulative = 0;
+    for (const auto& item : weighted) {
+        cumulative += item.second;
+        if (cumulative >= rank) return item.first;
+    }
+    return weighted.back().first;
+}
+
+std::vector<double> approximate_age_quantiles(const std::vector<Employee>& employees,
+                                              const std::string& target_position,
+                                              const std::vector<double>& quantiles,
+                                              int num_threads) {
+    ThreadPool& pool = ThreadPool::shared(num_threads);
+    SketchAccumulator acc = pool.parallel_reduce<SketchAccumulator>(
+        0, employees.size(),
+        [&](size_t begin, size_t end, SketchAccumulator& local) {
+            for (size_t j = begin; j < end; ++j) {
+                if (employees[j].position == target_position) {
+                    local.sketch.add(employees[j].age);
+                }
+            }
+        });
+
+    std::vector<double> result;
+    for (double q : quantiles) {
+        result.push_back(acc.sketch.quantile(q));
+    }
+    return result;
+}
+
+void run_topk_benchmark() {
+    std::cout << "\n=== Бенчмарк top-K и квантилей ===\n";
+
+    std::string target_position = "Инженер";
+    const int table_size = 1000000;
+    const int num_threads = 4;
+    std::vector<size_t> k_values = {10, 100, 1000};
+    std::vector<double> quantiles = {0.5, 0.9};
+
+    auto employees = generate_employees(table_size, target_position);
+    std::vector<std::pair<std::string, double>> benchmark_results;
+
+    // top-K: ограниченные кучи против сортировки отфильтрованного набора
+    for (size_t k : k_values) {
+        std::vector<Employee> heap_top, sorted_top;
+        double heap_time, sort_time;
+
+        {
+            Benchmark b("Кучи", false);
+            heap_top = top_k_near_average(employees, target_position, k, num_threads);
+            heap_time = b.elapsed_microseconds();
+        }
+
+        {
+            Benchmark b("Сортировка", false);
+            double average_age = calculate_average_age(employees, target_position);
+            std::vector<Employee> filtered;
+            for (const auto& emp : employees) {
+                if (emp.position == target_position && std::abs(emp.age - average_age) <= 2) {
+                    filtered.push_back(emp);
+                }
+            }
+            std::stable_sort(filtered.begin(), filtered.end(),
+                             [](const Employee& a, const Employee& b) { return a.salary > b.salary; });
+            if (filtered.size() > k) filtered.resize(k);
+            sorted_top = std::move(filtered);
+            sort_time = b.elapsed_microseconds();
+        }
+
+        bool same = heap_top.size() == sorted_top.size();
+        for (size_t i = 0; same && i < heap_top.size(); ++i) {
+            same = heap_top[i].salary == sorted_top[i].salary;
+        }
+        if (!same) {
+            std::cerr << "Ошибка: top-" << k << " не совпадает с сортировкой\n";
+        }
+
+        std::cout << "top-" << k << ": кучи " << std::fixed << std::setprecision(2) << heap_time
+                  << " мкс, сортировка " << sort_time << " мкс\n";
+        benchmark_results.emplace_back("top" + std::to_string(k) + "_кучи", heap_time);
+        benchmark_results.emplace_back("top" + std::to_string(k) + "_сортировка", sort_time);
+    }
+
+    // Квантили возраста по каждой должности
+    std::vector<std::string> positions = {"Менеджер", "Разработчик", "Аналитик", "Тестировщик",
+                                          "Дизайнер", "Администратор", "Бухгалтер", target_position};
+    double exact_time = 0.0, sketch_time = 0.0, sort_time = 0.0;
+
+    std::cout << "\nДолжность: медиана (точная / эскиз), p90 (точная / эскиз)\n";
+
+    for (const auto& position : positions) {
+        std::vector<int> exact, sorted_values;
+        std::vector<double> approx;
+
+        {
+            Benchmark b("Точные", false);
+            exact = exact_age_quantiles(employees, position, quantiles, num_threads);
+            exact_time += b.elapsed_microseconds();
+        }
+
+        {
+            Benchmark b("Эскиз", false);
+            approx = approximate_age_quantiles(employees, position, quantiles, num_threads);
+            sketch_time += b.elapsed_microseconds();
+        }
+
+        {
+            Benchmark b("Сортировка", false);
+            std::vector<int> ages;
+            for (const auto& emp : employees) {
+                if (emp.position == position) ages.push_back(emp.age);
+            }
+            std::sort(ages.begin(), ages.end());
+            for (double q : quantiles) {
+                sorted_values.push_back(ages.empty() ? 0 : ages[quantile_rank(q, ages.size()) - 1]);
+            }
+            sort_time += b.elapsed_microseconds();
+        }
+
+        if (exact != sorted_values) {
+            std::cerr << "Ошибка: точные квантили для '" << position << "' не совпадают с сортировкой\n";
+        }
+
+        std::cout << position << ": " << exact[0] << " / " << approx[0]
+                  << ", " << exact[1] << " / " << approx[1] << "\n";
+    }
+
+    std::cout << "\nКвантили по всем должностям: параллельная выборка "
+              << std::fixed << std::setprecision(2) << exact_time << " мкс, эскиз "
+              << sketch_time << " мкс, сортировка " << sort_time << " мкс\n";
+
+    benchmark_results.emplace_back("квантили_выборка", exact_time);
+    benchmark_results.emplace_back("квантили_эскиз", sketch_time);
+    benchmark_results.emplace_back("квантили_сортировка", sort_time);
+
+    Benchmark::save_to_csv(benchmark_results, "topk_benchmark.csv");
+}
+
+} // namespace task2
@@ -0,0 +1,62 @@
+#ifndef TASK2_TOPK_H
+#define TASK2_TOPK_H
+
+#include "task2_employees.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace task2 {
+
+// K сотрудников с наибольшей зарплатой среди сотрудников должности,
+// чей возраст отличается от среднего не более чем на age_range.
+// У каждого исполнителя своя ограниченная куча, затем k-путевое слияние.
+std::vector<Employee> top_k_near_average(const std::vector<Employee>& employees,
+                                         const std::string& target_position,
+                                         size_t k,
+                                         int num_threads,
+                                         int age_range = 2);
+
+// Точные квантили возраста должности (ранговое определение: элемент с
+// номером ceil(q * n) в упорядоченном наборе). Параллельная выборка
+// подсчетом: гистограммы возрастов исполнителей сливаются, затем квантили
+// находятся по накопленным частотам.
+std::vector<int> exact_age_quantiles(const std::vector<Employee>& employees,
+                                     const std::string& target_position,
+                                     const std::vector<double>& quantiles,
+                                     int num_threads);
+
+// Приближенные квантили с помощью сливаемого потокового эскиза KLL
+class QuantileSketch {
+public:
+    QuantileSketch() : QuantileSketch(200) {}
+    explicit QuantileSketch(int k);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    double quantile(double q) const;
+    size_t count() const { return count_; }
+    size_t retained() const;
+
+private:
+    int k_;
+    size_t count_ = 0;
+    std::vector<std::vector<double>> levels_;
+    std::mt19937 gen_;
+
+    size_t level_capacity(size_t level) const;
+    void compress();
+};
+
+std::vector<double> approximate_age_quantiles(const std::vector<Employee>& employees,
+                                              const std::string& target_position,
+                                              const std::vector<double>& quantiles,
+                                              int num_threads);
+
+// Бенчмарк: top-K и квантили против сортировки всего отфильтрованного набора
+void run_topk_benchmark();
+
+} // namespace task2
+
+#endif // TASK2_TOPK_H
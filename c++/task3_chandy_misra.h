@@ -0,0 +1,347 @@
+#ifndef TASK3_CHANDY_MISRA_H
+#define TASK3_CHANDY_MISRA_H
+
+#include "bounded_queue.h"
+#include <chrono>
+#include <cstdint>
+#include <semaphore>
+#include <vector>
+
+namespace task3 {
+
+// Сообщение протокола Чанди-Мисры. side - сторона получателя: левая вилка
+// отправителя для его левого соседа является правой.
+struct ChandyMisraMessage {
+    enum Kind : uint8_t {
+        REQUEST,   // отдай вилку
+        FORK,      // вилка (всегда чистая)
+        TIMER      // истекло время размышления или еды (только сопрограммы)
+    };
+
+    Kind kind = TIMER;
+    uint8_t side = 0;
+};
+
+// Состояние одного философа в "гигиеническом" решении Чанди-Мисры.
+// Вилка принадлежит одному из двух соседей и бывает чистой или грязной.
+// Голодный философ просит недостающие вилки; грязную вилку владелец
+// отдает по первой просьбе (почистив), чистую и вилку во время еды
+// придерживает до конца трапезы. После еды обе вилки грязные.
+// Изначально каждая вилка грязная у философа с меньшим номером, так что
+// граф предшествования ацикличен - нет ни взаимной блокировки, ни голодания.
+//
+// Состояние меняет только его владелец; send(side, kind) доставляет
+// сообщение соседу с этой стороны.
+class ChandyMisraPhilosopher {
+public:
+    enum class State : uint8_t { THINKING, HUNGRY, EATING, DONE };
+    static constexpr int kLeft = 0;
+    static constexpr int kRight = 1;
+
+    ChandyMisraPhilosopher() = default;
+
+    // Левая вилка id лежит между id-1 и id, правая - между id и id+1
+    ChandyMisraPhilosopher(int id, int n) {
+        has_[kLeft] = id == 0;
+        has_[kRight] = id != n - 1;
+    }
+
+    State state() const { return state_; }
+    bool can_eat() const { return state_ == State::HUNGRY && has_[kLeft] && has_[kRight]; }
+
+    template <typename Send>
+    void become_hungry(Send&& send) {
+        state_ = State::HUNGRY;
+        for (int side : {kLeft, kRight}) {
+            if (!has_[side] && !requested_[side]) {
+                requested_[side] = true;
+                send(side, ChandyMisraMessage::REQUEST);
+            }
+        }
+    }
+
+    void start_eating() { state_ = State::EATING; }
+
+    template <typename Send>
+    void on_request(int side, Send&& send) {
+        if (!has_[side]) return;
+
+        bool keep = state_ == State::EATING || (state_ == State::HUNGRY && !dirty_[side]);
+        if (keep) {
+            deferred_[side] = true;
+            return;
+        }
+        give(side, send);
+
+        // Отдали грязную вилку, будучи голодным, - сразу просим ее обратно
+        if (state_ == State::HUNGRY) {
+            requested_[side] = true;
+            send(side, ChandyMisraMessage::REQUEST);
+        }
+    }
+
+    void on_fork(int side) {
+        has_[side] = true;
+        dirty_[side] = false;
+        requested_[side] = false;
+    }
+
+    template <typename Send>
+    void receive(ChandyMisraMessage message, Send&& send) {
+        if (message.kind == ChandyMisraMessage::REQUEST) {
+            on_request(message.side, send);
+        } else {
+            on_fork(message.side);
+        }
+    }
+
+    template <typename Send>
+    void finish_eating(Send&& send) {
+        state_ = State::THINKING;
+        dirty_[kLeft] = dirty_[kRight] = true;
+        for (int side : {kLeft, kRight}) {
+            if (deferred_[side]) give(side, send);
+        }
+    }
+
+    // Последняя трапеза: оставшиеся вилки уходят соседям без просьбы
+    template <typename Send>
+    void leave(Send&& send) {
+        state_ = State::DONE;
+        for (int side : {kLeft, kRight}) {
+            if (has_[side]) give(side, send);
+        }
+    }
+
+private:
+    template <typename Send>
+    void give(int side, Send& send) {
+        has_[side] = false;
+        deferred_[side] = false;
+        send(side, ChandyMisraMessage::FORK);
+    }
+
+    State state_ = State::THINKING;
+    bool has_[2] = {false, false};
+    bool dirty_[2] = {true, true};
+    bool requested_[2] = {false, false};
+    bool deferred_[2] = {false, false};
+};
+
+// Сообщение Чанди-Мисры в общем графе: edge - номер вилки у получателя
+struct DrinkingMessage {
+    ChandyMisraMessage::Kind kind = ChandyMisraMessage::REQUEST;
+    int edge = 0;
+};
+
+// То же решение на произвольном графе конфликтов ("пьющие философы"):
+// своя вилка на каждую пару соседей, то есть задач с общим ресурсом.
+// Вилка e связывает философа с neighbors[e]; изначально она грязная у
+// меньшего номера. Есть можно, собрав все вилки. send(e, kind) доставляет
+// сообщение соседу neighbors[e].
+class ChandyMisraDrinker {
+public:
+    using State = ChandyMisraPhilosopher::State;
+
+    ChandyMisraDrinker(int id, const std::vector<int>& neighbors)
+        : has_(neighbors.size()), dirty_(neighbors.size(), true),
+          requested_(neighbors.size()), deferred_(neighbors.size()) {
+        for (size_t e = 0; e < neighbors.size(); ++e) {
+            has_[e] = id < neighbors[e];
+            if (!has_[e]) ++missing_;
+        }
+    }
+
+    State state() const { return state_; }
+    bool can_eat() const { return state_ == State::HUNGRY && missing_ == 0; }
+
+    // Сколько раз голодный философ отдал грязную вилку и попросил снова
+    long long reclaims() const { return reclaims_; }
+
+    template <typename Send>
+    void become_hungry(Send&& send) {
+        state_ = State::HUNGRY;
+        for (size_t e = 0; e < has_.size(); ++e) {
+            if (!has_[e] && !requested_[e]) {
+                requested_[e] = true;
+                send(e, ChandyMisraMessage::REQUEST);
+            }
+        }
+    }
+
+    void start_eating() { state_ = State::EATING; }
+
+    template <typename Send>
+    void on_request(size_t e, Send&& send) {
+        if (!has_[e]) return;
+
+        bool keep = state_ == State::EATING || (state_ == State::HUNGRY && !dirty_[e]);
+        if (keep) {
+            deferred_[e] = true;
+            return;
+        }
+        give(e, send);
+
+        if (state_ == State::HUNGRY) {
+            ++reclaims_;
+            requested_[e] = true;
+            send(e, ChandyMisraMessage::REQUEST);
+        }
+    }
+
+    void on_fork(size_t e) {
+        if (!has_[e]) --missing_;
+        has_[e] = true;
+        dirty_[e] = false;
+        requested_[e] = false;
+    }
+
+    template <typename Send>
+    void receive(DrinkingMessage message, Send&& send) {
+        if (message.kind == ChandyMisraMessage::REQUEST) {
+            on_request(message.edge, send);
+        } else {
+            on_fork(message.edge);
+        }
+    }
+
+    template <typename Send>
+    void finish_eating(Send&& send) {
+        state_ = State::THINKING;
+        for (size_t e = 0; e < has_.size(); ++e) {
+            dirty_[e] = true;
+            if (deferred_[e]) give(e, send);
+        }
+    }
+
+    template <typename Send>
+    void leave(Send&& send) {
+        state_ = State::DONE;
+        for (size_t e = 0; e < has_.size(); ++e) {
+            if (has_[e]) give(e, send);
+        }
+    }
+
+private:
+    template <typename Send>
+    void give(size_t e, Send& send) {
+        has_[e] = false;
+        ++missing_;
+        deferred_[e] = false;
+        send(e, ChandyMisraMessage::FORK);
+    }
+
+    State state_ = State::THINKING;
+    std::vector<bool> has_;
+    std::vector<bool> dirty_;
+    std::vector<bool> requested_;
+    std::vector<bool> deferred_;
+    size_t missing_ = 0;
+    long long reclaims_ = 0;
+};
+
+// Почтовый ящик потока-философа: несколько отправителей (соседи), один
+// получатель. Очередь без блокировок, семафор считает сообщения и
+// усыпляет получателя, пока ящик пуст. От каждого соседа в пути не больше
+// двух сообщений на вилку: кольцу хватает 8 ячеек, в общем графе
+// нужно 2 ячейки на каждую вилку философа.
+template <typename Message>
+class BasicMailbox {
+public:
+    explicit BasicMailbox(size_t capacity = 8) : queue_(capacity) {}
+
+    void post(Message message) {
+        queue_.push(message);
+        signal_.release();
+    }
+
+    // Семафор захвачен - сообщение уже в очереди
+    bool wait_until(std::chrono::steady_clock::time_point deadline) {
+        return signal_.try_acquire_until(deadline);
+    }
+    void wait() { signal_.acquire(); }
+    bool try_wait() { return signal_.try_acquire(); }
+
+    Message take() {
+        Message message;
+        while (!queue_.try_pop(message)) {}
+        return message;
+    }
+
+private:
+    BoundedQueue<Message> queue_;
+    std::counting_semaphore<> signal_{0};
+};
+
+using ChandyMisraMailbox = BasicMailbox<ChandyMisraMessage>;
+
+// Цикл потока Чанди-Мисры, общий для кольца (ChandyMisraPhilosopher) и
+// графа ресурсов (ChandyMisraDrinker). Вместо sleep_for философ ждет почту
+// до конца размышления или еды: просьбы соседей обслуживаются и во время
+// размышления. При занятом ожидании работа выполняется целиком, затем
+// разбирается почта, пришедшая за это время.
+//
+// Host задает время и отмечает переходы: think_time(), eat_time(),
+// pass_time(d) (только busy_wait), hungry(meal), eating(meal), done(meal),
+// где meal - номер трапезы с нуля.
+template <typename Agent, typename Mailbox, typename Send, typename Host>
+void run_chandy_misra(Agent& self, Mailbox& inbox, Send&& send, int iterations,
+                      bool busy_wait, Host& host) {
+    using State = ChandyMisraPhilosopher::State;
+    using Clock = std::chrono::steady_clock;
+    using Duration = decltype(host.think_time());
+
+    int meals = 0;
+    bool timed = true;
+    bool work_pending = false;
+    Duration work{0};
+    Clock::time_point deadline;
+    auto start_timer = [&](Duration duration) {
+        work = duration;
+        work_pending = true;
+        deadline = Clock::now() + duration;
+        timed = true;
+    };
+    start_timer(host.think_time());
+
+    while (self.state() != State::DONE) {
+        bool got_message = true;
+        if (!timed) {
+            inbox.wait();
+        } else if (busy_wait) {
+            if (work_pending) {
+                host.pass_time(work);
+                work_pending = false;
+            }
+            got_message = inbox.try_wait();
+        } else {
+            got_message = inbox.wait_until(deadline);
+        }
+
+        if (got_message) {
+            self.receive(inbox.take(), send);
+        } else if (self.state() == State::THINKING) {
+            host.hungry(meals);
+            self.become_hungry(send);
+            timed = false;
+        } else {
+            host.done(meals);
+            self.finish_eating(send);
+            if (++meals == iterations) {
+                self.leave(send);
+            } else {
+                start_timer(host.think_time());
+            }
+        }
+
+        if (self.can_eat()) {
+            host.eating(meals);
+            self.start_eating();
+            start_timer(host.eat_time());
+        }
+    }
+}
+
+} // namespace task3
+
+#endif // TASK3_CHANDY_MISRA_H
@@ -0,0 +1,569 @@
+#include "task3_coroutines.h"
+#include "benchmark_utils.h"
+#include "task3_chandy_misra.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <random>
+
+using namespace std::chrono_literals;
+
+namespace task3 {
+
+TimerWheel::TimerWheel(ThreadPool& executor)
+    : executor_(executor), thread_(&TimerWheel::run, this) {}
+
+TimerWheel::~TimerWheel() {
+    stop_.store(true, std::memory_order_relaxed);
+    thread_.join();
+}
+
+void TimerWheel::add(int delay_ms, std::coroutine_handle<> handle) {
+    uint64_t deadline = current_tick_.load(std::memory_order_acquire) + std::max(1, delay_ms);
+    Slot& slot = slots_[deadline % kSlots];
+    {
+        std::lock_guard<std::mutex> lock(slot.mtx);
+        // Тик ячейки уже обработан (поток колеса обогнал нас) - будим сразу,
+        // иначе запись ждала бы полный оборот
+        if (deadline > current_tick_.load(std::memory_order_acquire)) {
+            slot.entries.push_back(Entry{deadline, handle});
+            return;
+        }
+    }
+    fired_.fetch_add(1, std::memory_order_relaxed);
+    executor_.submit([handle]() { handle.resume(); });
+}
+
+void TimerWheel::run() {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t tick = 0;
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(start + (tick + 1) * 1ms);
+
+        // После задержки потока обрабатываем все пропущенные тики подряд
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        uint64_t target = static_cast<uint64_t>(elapsed.count());
+        while (tick < target) {
+            fire(++tick);
+        }
+    }
+}
+
+void TimerWheel::fire(uint64_t tick) {
+    std::vector<std::coroutine_handle<>> due;
+    {
+        Slot& slot = slots_[tick % kSlots];
+        std::lock_guard<std::mutex> lock(slot.mtx);
+        auto& entries = slot.entries;
+        for (size_t i = 0; i < entries.size();) {
+            if (entries[i].deadline <= tick) {
+                due.push_back(entries[i].handle);
+                entries[i] = entries.back();
+                entries.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        // Под мьютексом ячейки: add с этим тиком увидит, что он прошел
+        current_tick_.store(tick, std::memory_order_release);
+    }
+
+    fired_.fetch_add(due.size(), std::memory_order_relaxed);
+    for (auto handle : due) {
+        executor_.submit([handle]() { handle.resume(); });
+    }
+}
+
+bool AsyncMutex::try_lock() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (locked_) return false;
+    locked_ = true;
+    return true;
+}
+
+bool AsyncMutex::LockAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+
+    std::lock_guard<std::mutex> lock(mutex_.mtx_);
+    if (!mutex_.locked_) {
+        mutex_.locked_ = true;
+        return false;
+    }
+    if (mutex_.tail_) {
+        mutex_.tail_->next_ = this;
+    } else {
+        mutex_.head_ = this;
+    }
+    mutex_.tail_ = this;
+    return true;
+}
+
+void AsyncMutex::unlock(ThreadPool& executor) {
+    LockAwaiter* next;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        next = head_;
+        if (!next) {
+            locked_ = false;
+            return;
+        }
+        // Вилка переходит ожидающему, не освобождаясь
+        head_ = next->next_;
+        if (!head_) tail_ = nullptr;
+    }
+    std::coroutine_handle<> handle = next->handle_;
+    executor.submit_local([handle]() { handle.resume(); });
+}
+
+double CoroutineStats::meals_per_second() const {
+    return wall_seconds > 0.0 ? meals / wall_seconds : 0.0;
+}
+
+namespace {
+
+using Strategy = DiningPhilosophers::Strategy;
+
+// Сопрограмма философа: стартует приостановленной, кадр уничтожается
+// сам по завершении тела
+struct PhilosopherTask {
+    struct promise_type {
+        PhilosopherTask get_return_object() {
+            return PhilosopherTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Запущенная сразу сопрограмма без владельца (отложенная отправка сообщения)
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Почтовый ящик философа-сопрограммы для Чанди-Мисры: та же очередь без
+// блокировок, что у потоков, а вместо семафора - счетчик сообщений.
+// Отрицательный счетчик означает, что получатель приостановлен и его
+// должен возобновить отправитель.
+class CoroutineMailbox {
+public:
+    void post(ChandyMisraMessage message, ThreadPool& executor) {
+        queue_.push(message);
+        if (count_.fetch_add(1, std::memory_order_acq_rel) < 0) {
+            std::coroutine_handle<> handle = parked_;
+            executor.submit_local([handle]() { handle.resume(); });
+        }
+    }
+
+    struct ReceiveAwaiter {
+        CoroutineMailbox& box;
+
+        bool await_ready() const noexcept { return false; }
+        // Ручка сохраняется до уменьшения счетчика: отправитель, увидевший
+        // -1, уже видит и ее
+        bool await_suspend(std::coroutine_handle<> handle) {
+            box.parked_ = handle;
+            return box.count_.fetch_sub(1, std::memory_order_acq_rel) <= 0;
+        }
+        ChandyMisraMessage await_resume() {
+            ChandyMisraMessage message;
+            while (!box.queue_.try_pop(message)) {}
+            return message;
+        }
+    };
+
+    ReceiveAwaiter receive() { return ReceiveAwaiter{*this}; }
+
+private:
+    BoundedQueue<ChandyMisraMessage> queue_{8};
+    std::atomic<int> count_{0};
+    std::coroutine_handle<> parked_;
+};
+
+class CoroutineTable {
+public:
+    CoroutineTable(int n, Strategy strategy, int iterations, const BackoffPolicy& backoff,
+                   int workers, bool verbose)
+        : n_(n), strategy_(strategy), iterations_(iterations), backoff_(backoff), verbose_(verbose),
+          forks_(n), available_(n, 1), waiting_(n),
+          mailboxes_(strategy == Strategy::CHANDY_MISRA ? n : 0),
+          fork_words_(strategy == Strategy::ATOMIC_BITMASK ? (n + 63) / 64 : 0), remaining_(n),
+          pool_(workers + 1), wheel_(pool_) {}
+
+    CoroutineStats run() {
+        Benchmark wall("Философы-сопрограммы", false);
+
+        // Вызывающий поток только ждет, сопрограммы выполняют фоновые потоки
+        std::random_device rd;
+        uint32_t seed = rd();
+        for (int id = 0; id < n_; ++id) {
+            auto handle = strategy_ == Strategy::CHANDY_MISRA ? chandy_misra(id, seed + id).handle
+                                                              : philosopher(id, seed + id).handle;
+            pool_.submit([handle]() { handle.resume(); });
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(done_mutex_);
+            done_cv_.wait(lock, [this]() { return remaining_ == 0; });
+        }
+
+        CoroutineStats stats;
+        stats.wall_seconds = wall.elapsed_seconds();
+        stats.meals = meals_.load();
+        stats.average_wait_ms = stats.meals > 0 ? total_wait_us_.load() / 1000.0 / stats.meals : 0.0;
+        stats.max_wait_ms = max_wait_us_.load() / 1000.0;
+        stats.timers = wheel_.timers_fired();
+        stats.workers = pool_.size() - 1;
+        return stats;
+    }
+
+private:
+    PhilosopherTask philosopher(int id, uint32_t seed) {
+        // minstd_rand вместо mt19937: 8 байт в кадре против 5 КБ
+        std::minstd_rand gen(seed);
+        std::uniform_int_distribution<> think_dist(50, 200);
+        std::uniform_int_distribution<> eat_dist(100, 300);
+
+        int left = id;
+        int right = (id + 1) % n_;
+        int first = left, second = right;
+        if (strategy_ == Strategy::MUTEX && id % 2 != 0) {
+            std::swap(first, second);
+        } else if (strategy_ == Strategy::RESOURCE_HIERARCHY) {
+            first = std::min(left, right);
+            second = std::max(left, right);
+        }
+
+        for (int i = 0; i < iterations_; ++i) {
+            co_await sleep_for(wheel_, think_dist(gen));
+            print(id, i, " размышляет");
+
+            auto hungry_since = std::chrono::steady_clock::now();
+            switch (strategy_) {
+                case Strategy::TRY_LOCK: {
+                    Backoff backoff(backoff_);
+                    while (true) {
+                        if (forks_[left].try_lock()) {
+                            if (forks_[right].try_lock()) break;
+                            forks_[left].unlock(pool_);
+                        }
+                        Backoff::Delay delay = backoff.next(gen);
+                        if (delay.spin) {
+                            busy_work(delay.duration);
+                        } else {
+                            auto ms = std::chrono::ceil<std::chrono::milliseconds>(delay.duration);
+                            co_await sleep_for(wheel_, static_cast<int>(ms.count()));
+                        }
+                    }
+                    break;
+                }
+                case Strategy::ARBITRATOR:
+                    // Короткая проверка под мьютексом арбитра, отказ - пауза 10 мс
+                    while (!ask_arbitrator(left, right)) {
+                        co_await sleep_for(wheel_, 10);
+                    }
+                    break;
+                case Strategy::WAITER:
+                    co_await WaiterAwaiter{*this, id};
+                    break;
+                case Strategy::ATOMIC_BITMASK: {
+                    ForkWord& left_word = fork_words_[left / 64];
+                    ForkWord& right_word = fork_words_[right / 64];
+                    uint64_t left_bit = 1ULL << (left % 64);
+                    uint64_t right_bit = 1ULL << (right % 64);
+                    uint64_t observed;
+                    if (&left_word == &right_word) {
+                        while (!try_set_bits(left_word.bits, left_bit | right_bit, observed)) {
+                            co_await WordWaitAwaiter{left_word, left_bit | right_bit};
+                        }
+                    } else {
+                        // Граница слов: правая занята - левая возвращается
+                        while (true) {
+                            if (!try_set_bits(left_word.bits, left_bit, observed)) {
+                                co_await WordWaitAwaiter{left_word, left_bit};
+                                continue;
+                            }
+                            if (try_set_bits(right_word.bits, right_bit, observed)) break;
+                            clear_bits(left_word, left_bit);
+                            co_await WordWaitAwaiter{right_word, right_bit};
+                        }
+                    }
+                    break;
+                }
+                default:
+                    co_await forks_[first].lock();
+                    co_await forks_[second].lock();
+            }
+            record_wait(std::chrono::steady_clock::now() - hungry_since);
+
+            co_await sleep_for(wheel_, eat_dist(gen));
+            print(id, i, " ест спагетти");
+
+            if (strategy_ == Strategy::ARBITRATOR) {
+                std::lock_guard<std::mutex> lock(table_mutex_);
+                available_[left] = 1;
+                available_[right] = 1;
+            } else if (strategy_ == Strategy::WAITER) {
+                release_to_neighbors(id);
+            } else if (strategy_ == Strategy::ATOMIC_BITMASK) {
+                clear_bits(fork_words_[left / 64], 1ULL << (left % 64));
+                clear_bits(fork_words_[right / 64], 1ULL << (right % 64));
+            } else if (strategy_ == Strategy::RESOURCE_HIERARCHY) {
+                forks_[second].unlock(pool_);
+                forks_[first].unlock(pool_);
+            } else {
+                forks_[left].unlock(pool_);
+                forks_[right].unlock(pool_);
+            }
+            meals_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        finish();
+    }
+
+    // Чанди-Мисра: философ - актор, который только принимает почту.
+    // Конец размышления и еды приходит в тот же ящик сообщением TIMER,
+    // поэтому просьбы соседей обслуживаются и во время размышления.
+    PhilosopherTask chandy_misra(int id, uint32_t seed) {
+        using Message = ChandyMisraMessage;
+        using State = ChandyMisraPhilosopher::State;
+
+        std::minstd_rand gen(seed);
+        std::uniform_int_distribution<> think_dist(50, 200);
+        std::uniform_int_distribution<> eat_dist(100, 300);
+
+        ChandyMisraPhilosopher self(id, n_);
+        int left_neighbor = (id + n_ - 1) % n_;
+        int right_neighbor = (id + 1) % n_;
+        auto send = [&](int side, Message::Kind kind) {
+            int to = side == ChandyMisraPhilosopher::kLeft ? left_neighbor : right_neighbor;
+            mailboxes_[to].post(Message{kind, static_cast<uint8_t>(1 - side)}, pool_);
+        };
+
+        int meals = 0;
+        auto hungry_since = std::chrono::steady_clock::now();
+        post_after(think_dist(gen), id);
+
+        while (self.state() != State::DONE) {
+            Message message = co_await mailboxes_[id].receive();
+
+            if (message.kind == Message::REQUEST) {
+                self.on_request(message.side, send);
+            } else if (message.kind == Message::FORK) {
+                self.on_fork(message.side);
+            } else if (self.state() == State::THINKING) {
+                print(id, meals, " размышляет");
+                hungry_since = std::chrono::steady_clock::now();
+                self.become_hungry(send);
+            } else {
+                print(id, meals, " ест спагетти");
+                self.finish_eating(send);
+                meals_.fetch_add(1, std::memory_order_relaxed);
+                if (++meals == iterations_) {
+                    self.leave(send);
+                } else {
+                    post_after(think_dist(gen), id);
+                }
+            }
+
+            if (self.can_eat()) {
+                record_wait(std::chrono::steady_clock::now() - hungry_since);
+                self.start_eating();
+                post_after(eat_dist(gen), id);
+            }
+        }
+
+        finish();
+    }
+
+    DetachedTask post_after(int delay_ms, int id) {
+        co_await sleep_for(wheel_, delay_ms);
+        mailboxes_[id].post(ChandyMisraMessage{}, pool_);
+    }
+
+    void finish() {
+        std::lock_guard<std::mutex> lock(done_mutex_);
+        if (--remaining_ == 0) done_cv_.notify_one();
+    }
+
+    bool ask_arbitrator(int left, int right) {
+        std::lock_guard<std::mutex> lock(table_mutex_);
+        if (!available_[left] || !available_[right]) return false;
+        available_[left] = 0;
+        available_[right] = 0;
+        return true;
+    }
+
+    // Официант: свободные вилки берутся сразу, иначе сопрограмма
+    // остается в очереди, пока сосед не передаст ей вилки
+    struct WaiterAwaiter {
+        CoroutineTable& table;
+        int id;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) { return table.enqueue_waiter(id, handle); }
+        void await_resume() const noexcept {}
+    };
+
+    bool enqueue_waiter(int id, std::coroutine_handle<> handle) {
+        std::lock_guard<std::mutex> lock(table_mutex_);
+        if (ask_waiter(id)) return false;
+        waiting_[id] = Waiting{++next_ticket_, handle};
+        return true;
+    }
+
+    // Под table_mutex_: занять обе вилки философа id, если они свободны
+    bool ask_waiter(int id) {
+        int left = id, right = (id + 1) % n_;
+        if (!available_[left] || !available_[right]) return false;
+        available_[left] = 0;
+        available_[right] = 0;
+        return true;
+    }
+
+    // Освободились вилки двух соседей, первым получает тот, кто дольше ждет
+    void release_to_neighbors(int id) {
+        std::coroutine_handle<> woken[2];
+        int num_woken = 0;
+        {
+            std::lock_guard<std::mutex> lock(table_mutex_);
+            available_[id] = 1;
+            available_[(id + 1) % n_] = 1;
+
+            int first = (id + n_ - 1) % n_, second = (id + 1) % n_;
+            if (waiting_[second].ticket != 0 &&
+                (waiting_[first].ticket == 0 || waiting_[second].ticket < waiting_[first].ticket)) {
+                std::swap(first, second);
+            }
+            for (int p : {first, second}) {
+                if (waiting_[p].ticket == 0 || !ask_waiter(p)) continue;
+                woken[num_woken++] = waiting_[p].handle;
+                waiting_[p] = Waiting{};
+            }
+        }
+        for (int k = 0; k < num_woken; ++k) {
+            std::coroutine_handle<> handle = woken[k];
+            pool_.submit_local([handle]() { handle.resume(); });
+        }
+    }
+
+    // Битовая маска: слово вилок и сопрограммы, ждущие его изменения
+    // (аналог фьютекса по адресу слова)
+    struct alignas(kCacheLineSize) ForkWord {
+        std::atomic<uint64_t> bits{0};
+        std::atomic<int> parked{0};
+        std::mutex mtx;
+        std::vector<std::coroutine_handle<>> waiters;
+    };
+
+    // Счетчик увеличивается до повторной проверки слова, а освобождение
+    // меняет слово до чтения счетчика, так что пробуждение не теряется
+    struct WordWaitAwaiter {
+        ForkWord& word;
+        uint64_t mask;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(word.mtx);
+            word.parked.fetch_add(1);
+            if ((word.bits.load() & mask) == 0) {
+                word.parked.fetch_sub(1);
+                return false;
+            }
+            word.waiters.push_back(handle);
+            return true;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    void clear_bits(ForkWord& word, uint64_t mask) {
+        word.bits.fetch_and(~mask);
+        if (word.parked.load() == 0) return;
+
+        std::vector<std::coroutine_handle<>> woken;
+        {
+            std::lock_guard<std::mutex> lock(word.mtx);
+            woken.swap(word.waiters);
+            word.parked.fetch_sub(static_cast<int>(woken.size()));
+        }
+        for (auto handle : woken) {
+            pool_.submit_local([handle]() { handle.resume(); });
+        }
+    }
+
+    void record_wait(std::chrono::steady_clock::duration wait) {
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(wait).count();
+        total_wait_us_.fetch_add(us, std::memory_order_relaxed);
+        long long prev = max_wait_us_.load(std::memory_order_relaxed);
+        while (prev < us && !max_wait_us_.compare_exchange_weak(prev, us, std::memory_order_relaxed)) {}
+    }
+
+    void print(int id, int iteration, const char* action) {
+        if (!verbose_ || iteration >= 10) return;
+        std::lock_guard<std::mutex> lock(print_mutex_);
+        std::cout << "Философ " << id << action << " (итерация " << iteration + 1 << ")\n";
+    }
+
+    int n_;
+    Strategy strategy_;
+    int iterations_;
+    BackoffPolicy backoff_;
+    bool verbose_;
+
+    std::vector<AsyncMutex> forks_;
+    std::mutex table_mutex_;                  // арбитр и официант
+    std::vector<char> available_;
+
+    struct Waiting {
+        uint64_t ticket = 0;                  // 0 - не ждет
+        std::coroutine_handle<> handle;
+    };
+    std::vector<Waiting> waiting_;
+    uint64_t next_ticket_ = 0;
+
+    std::vector<CoroutineMailbox> mailboxes_;  // только для Чанди-Мисры
+    std::vector<ForkWord> fork_words_;         // только для битовой маски
+
+    std::atomic<long long> meals_{0};
+    std::atomic<long long> total_wait_us_{0};
+    std::atomic<long long> max_wait_us_{0};
+    std::mutex print_mutex_;
+
+    std::mutex done_mutex_;
+    std::condition_variable done_cv_;
+    int remaining_;
+
+    // Колесо объявлено последним: его поток останавливается раньше пула,
+    // а пул дожидается своих потоков раньше, чем уничтожаются вилки
+    ThreadPool pool_;
+    TimerWheel wheel_;
+};
+
+} // namespace
+
+CoroutineStats simulate_coroutines(int num_philosophers,
+                                   DiningPhilosophers::Strategy strategy,
+                                   int iterations,
+                                   const BackoffPolicy& backoff,
+                                   int workers,
+                                   bool verbose) {
+    if (workers <= 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    CoroutineTable table(std::max(2, num_philosophers), strategy, iterations, backoff, workers, verbose);
+    return table.run();
+}
+
+} // namespace task3
@@ -0,0 +1,135 @@
+#ifndef TASK3_COROUTINES_H
+#define TASK3_COROUTINES_H
+
+#include "task3_philosophers.h"
+#include "thread_pool.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace task3 {
+
+// Колесо таймеров с шагом 1 мс. Сопрограмма, заснувшая на d мс, попадает
+// в ячейку (текущий тик + d) % kSlots; поток колеса раз в тик забирает
+// наступившие записи своей ячейки и отдает их пулу. Записи следующих
+// оборотов остаются в ячейке до своего тика.
+class TimerWheel {
+public:
+    static constexpr size_t kSlots = 1024;
+
+    explicit TimerWheel(ThreadPool& executor);
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Возобновить handle в пуле не раньше чем через delay_ms
+    void add(int delay_ms, std::coroutine_handle<> handle);
+
+    uint64_t timers_fired() const { return fired_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        uint64_t deadline;
+        std::coroutine_handle<> handle;
+    };
+
+    struct Slot {
+        std::mutex mtx;
+        std::vector<Entry> entries;
+    };
+
+    void run();
+    void fire(uint64_t tick);
+
+    ThreadPool& executor_;
+    std::array<Slot, kSlots> slots_;
+    std::atomic<uint64_t> current_tick_{0};   // последний обработанный тик
+    std::atomic<uint64_t> fired_{0};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+// Ожидание на колесе таймеров: co_await sleep_for(wheel, ms)
+struct SleepAwaiter {
+    TimerWheel& wheel;
+    int delay_ms;
+
+    bool await_ready() const noexcept { return delay_ms <= 0; }
+    void await_suspend(std::coroutine_handle<> handle) { wheel.add(delay_ms, handle); }
+    void await_resume() const noexcept {}
+};
+
+inline SleepAwaiter sleep_for(TimerWheel& wheel, int delay_ms) {
+    return SleepAwaiter{wheel, delay_ms};
+}
+
+// Вилка, которую ждут без блокировки потока. Ожидающие образуют
+// интрузивный FIFO-список из объектов ожидания в кадрах сопрограмм;
+// unlock передает вилку первому из них и ставит его в очередь пула.
+class AsyncMutex {
+public:
+    class LockAwaiter {
+    public:
+        explicit LockAwaiter(AsyncMutex& mutex) : mutex_(mutex) {}
+
+        bool await_ready() { return mutex_.try_lock(); }
+        // false - вилка освободилась, пока шла постановка в очередь
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+
+    private:
+        friend class AsyncMutex;
+        AsyncMutex& mutex_;
+        std::coroutine_handle<> handle_;
+        LockAwaiter* next_ = nullptr;
+    };
+
+    AsyncMutex() = default;
+    AsyncMutex(const AsyncMutex&) = delete;
+    AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+    bool try_lock();
+    LockAwaiter lock() { return LockAwaiter(*this); }
+    void unlock(ThreadPool& executor);
+
+private:
+    std::mutex mtx_;
+    bool locked_ = false;
+    LockAwaiter* head_ = nullptr;
+    LockAwaiter* tail_ = nullptr;
+};
+
+// Итоги прогона философов-сопрограмм
+struct CoroutineStats {
+    long long meals = 0;
+    double wall_seconds = 0.0;
+    double average_wait_ms = 0.0;     // от голода до начала еды
+    double max_wait_ms = 0.0;
+    uint64_t timers = 0;              // срабатываний колеса таймеров
+    int workers = 0;                  // потоков пула (M для N философов)
+
+    double meals_per_second() const;
+};
+
+// Философы - сопрограммы C++20 на пуле из workers потоков с перехватом
+// задач. Размышление, еда и паузы повторных попыток - ожидание на колесе
+// таймеров, захват вилки - co_await AsyncMutex. Распределения времени
+// и порядок захвата вилок те же, что у потоковых реализаций; паузы try_lock
+// задает backoff (округляются вверх до миллисекунды колеса, вращение
+// выполняется на потоке пула). workers <= 0 - по числу аппаратных потоков.
+CoroutineStats simulate_coroutines(int num_philosophers,
+                                   DiningPhilosophers::Strategy strategy,
+                                   int iterations,
+                                   const BackoffPolicy& backoff = BackoffPolicy(),
+                                   int workers = 0,
+                                   bool verbose = false);
+
+} // namespace task3
+
+#endif // TASK3_COROUTINES_H
@@ -0,0 +1,646 @@
+#include "task3_drinking.h"
+#include "task3_chandy_misra.h"
+#include "benchmark_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace task3 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Больше потоков-задач в одном прогоне не запускаем
+constexpr int kMaxTasks = 1024;
+
+// Разброс вокруг среднего: [d/2, 3d/2]
+std::chrono::microseconds jittered(std::chrono::microseconds duration, std::mt19937& gen) {
+    if (duration.count() <= 1) return duration;
+    std::uniform_int_distribution<long long> dist(duration.count() / 2, duration.count() * 3 / 2);
+    return std::chrono::microseconds(dist(gen));
+}
+
+} // namespace
+
+std::vector<std::vector<int>> ResourceGraph::users() const {
+    std::vector<std::vector<int>> result(resources);
+    for (int t = 0; t < tasks(); ++t) {
+        for (int r : needs[t]) result[r].push_back(t);
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> ResourceGraph::conflicts() const {
+    std::vector<std::vector<int>> by_resource = users();
+    std::vector<std::vector<int>> result(tasks());
+    for (int t = 0; t < tasks(); ++t) {
+        for (int r : needs[t]) {
+            for (int other : by_resource[r]) {
+                if (other != t) result[t].push_back(other);
+            }
+        }
+        std::sort(result[t].begin(), result[t].end());
+        result[t].erase(std::unique(result[t].begin(), result[t].end()), result[t].end());
+    }
+    return result;
+}
+
+double ResourceGraph::average_resources() const {
+    if (empty()) return 0.0;
+    size_t total = 0;
+    for (const auto& task : needs) total += task.size();
+    return static_cast<double>(total) / tasks();
+}
+
+double ResourceGraph::conflict_density() const {
+    int n = tasks();
+    if (n < 2) return 0.0;
+    size_t edges = 0;
+    for (const auto& neighbors : conflicts()) edges += neighbors.size();
+    return static_cast<double>(edges) / (static_cast<double>(n) * (n - 1));
+}
+
+ResourceGraph ring_graph(int tasks) {
+    ResourceGraph graph;
+    graph.name = "кольцо_" + std::to_string(tasks);
+    graph.resources = tasks;
+    for (int t = 0; t < tasks; ++t) {
+        std::vector<int> needs = {t, (t + 1) % tasks};
+        std::sort(needs.begin(), needs.end());
+        needs.erase(std::unique(needs.begin(), needs.end()), needs.end());
+        graph.needs.push_back(needs);
+    }
+    return graph;
+}
+
+ResourceGraph random_graph(int tasks, int resources, int per_task, uint32_t seed) {
+    ResourceGraph graph;
+    per_task = std::clamp(per_task, 1, std::max(1, resources));
+    graph.name = "случайный_k" + std::to_string(per_task);
+    graph.resources = resources;
+
+    std::mt19937 gen(seed);
+    std::vector<int> pool(resources);
+    std::iota(pool.begin(), pool.end(), 0);
+
+    // Частичное перемешивание Фишера-Йейтса: первые per_task - выборка
+    for (int t = 0; t < tasks; ++t) {
+        for (int j = 0; j < per_task; ++j) {
+            std::uniform_int_distribution<int> dist(j, resources - 1);
+            std::swap(pool[j], pool[dist(gen)]);
+        }
+        std::vector<int> needs(pool.begin(), pool.begin() + per_task);
+        std::sort(needs.begin(), needs.end());
+        graph.needs.push_back(needs);
+    }
+    return graph;
+}
+
+ResourceGraph grid_graph(int rows, int cols) {
+    ResourceGraph graph;
+    graph.name = "решетка_" + std::to_string(rows) + "x" + std::to_string(cols);
+    graph.resources = (rows + 1) * (cols + 1);
+
+    auto node = [cols](int r, int c) { return r * (cols + 1) + c; };
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            graph.needs.push_back({node(r, c), node(r, c + 1), node(r + 1, c), node(r + 1, c + 1)});
+        }
+    }
+    return graph;
+}
+
+ResourceGraph load_resource_graph(const std::string& path) {
+    ResourceGraph graph;
+
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Ошибка: не удалось открыть файл " << path << "\n";
+        return graph;
+    }
+
+    std::string line;
+    bool header = true;
+    size_t bad_lines = 0;
+    while (std::getline(in, line)) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        std::istringstream fields(line);
+        if (header) {
+            if (!(fields >> graph.resources) || graph.resources <= 0) {
+                std::cerr << "Ошибка: первая строка " << path << " должна содержать число ресурсов\n";
+                return ResourceGraph();
+            }
+            header = false;
+            continue;
+        }
+
+        std::vector<int> needs;
+        int resource;
+        bool valid = true;
+        while (fields >> resource) {
+            if (resource < 0 || resource >= graph.resources) valid = false;
+            needs.push_back(resource);
+        }
+        if (!fields.eof() || !valid || needs.empty()) {
+            ++bad_lines;
+            continue;
+        }
+
+        std::sort(needs.begin(), needs.end());
+        needs.erase(std::unique(needs.begin(), needs.end()), needs.end());
+        graph.needs.push_back(needs);
+    }
+
+    if (bad_lines > 0) {
+        std::cerr << "Предупреждение: пропущено некорректных строк: " << bad_lines << "\n";
+    }
+    if (graph.tasks() > kMaxTasks) {
+        std::cerr << "Предупреждение: взяты первые " << kMaxTasks << " задач из " << graph.tasks() << "\n";
+        graph.needs.resize(kMaxTasks);
+    }
+    if (graph.empty()) {
+        std::cerr << "Ошибка: в файле " << path << " нет задач\n";
+        return ResourceGraph();
+    }
+
+    graph.name = path;
+    return graph;
+}
+
+struct DrinkingPhilosophers::ResourceTable {
+    explicit ResourceTable(const ResourceGraph& graph)
+        : mutexes(graph.resources), available(graph.resources, true),
+          waiter_cvs(graph.tasks()), waiting(graph.tasks(), 0),
+          users(graph.users()), neighbors(graph.conflicts()),
+          words((graph.resources + 63) / 64), word_masks(graph.tasks()) {
+        int n = graph.tasks();
+        reverse_edge.resize(n);
+        for (int t = 0; t < n; ++t) {
+            for (int other : neighbors[t]) {
+                const auto& back = neighbors[other];
+                reverse_edge[t].push_back(static_cast<int>(
+                    std::lower_bound(back.begin(), back.end(), t) - back.begin()));
+            }
+            size_t capacity = std::max<size_t>(8, 2 * neighbors[t].size());
+            mailboxes.push_back(std::make_unique<BasicMailbox<DrinkingMessage>>(capacity));
+
+            // Ресурсы отсортированы, так что и слова идут по возрастанию
+            for (int r : graph.needs[t]) {
+                uint64_t bit = 1ULL << (r % 64);
+                if (word_masks[t].empty() || word_masks[t].back().first != r / 64) {
+                    word_masks[t].push_back({r / 64, bit});
+                } else {
+                    word_masks[t].back().second |= bit;
+                }
+            }
+        }
+    }
+
+    std::vector<std::mutex> mutexes;          // мьютексы, try_lock, иерархия
+    std::mutex table_mutex;                   // арбитр и официант
+    std::vector<bool> available;
+
+    // Официант: waiting[t] - номер очереди задачи (0 - не ждет)
+    std::vector<std::condition_variable> waiter_cvs;
+    std::vector<uint64_t> waiting;
+    uint64_t next_ticket = 0;
+    std::vector<std::vector<int>> users;
+
+    // Чанди-Мисра: вилка e задачи t лежит между t и neighbors[t][e], у
+    // соседа это вилка reverse_edge[t][e]
+    std::vector<std::vector<int>> neighbors;
+    std::vector<std::vector<int>> reverse_edge;
+    std::vector<std::unique_ptr<BasicMailbox<DrinkingMessage>>> mailboxes;
+
+    // Битовая маска: (слово, биты) задачи по возрастанию слов
+    std::vector<std::atomic<uint64_t>> words;
+    std::vector<std::vector<std::pair<int, uint64_t>>> word_masks;
+
+    // Под table_mutex: отдать задаче все ресурсы, если она ждет и они свободны
+    bool hand_over(int task, const std::vector<int>& needs) {
+        if (waiting[task] == 0) return false;
+        for (int r : needs) {
+            if (!available[r]) return false;
+        }
+        for (int r : needs) available[r] = false;
+        waiting[task] = 0;
+        return true;
+    }
+};
+
+DrinkingPhilosophers::DrinkingPhilosophers(ResourceGraph graph, Strategy strategy,
+                                           DrinkingWorkload workload)
+    : graph_(std::move(graph)), strategy_(strategy), workload_(workload) {}
+
+DrinkingPhilosophers::~DrinkingPhilosophers() = default;
+
+bool DrinkingPhilosophers::supports(Strategy strategy) {
+    return strategy != Strategy::SEMAPHORE;
+}
+
+void DrinkingPhilosophers::pass_time(std::chrono::microseconds duration) const {
+    if (workload_.busy_wait) {
+        busy_work(duration);
+    } else {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+void DrinkingPhilosophers::retry_pause(std::chrono::microseconds duration) const {
+    if (workload_.busy_wait) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+void DrinkingPhilosophers::acquire(int id, std::mt19937& gen, TaskCounters& counters) {
+    if (graph_.needs[id].empty()) {
+        ++counters.attempts;
+        return;
+    }
+
+    switch (strategy_) {
+        case Strategy::MUTEX: acquire_mutex(id, counters); break;
+        case Strategy::TRY_LOCK: acquire_try_lock(id, gen, counters); break;
+        case Strategy::ARBITRATOR: acquire_arbitrator(id, counters); break;
+        case Strategy::WAITER: acquire_waiter(id, counters); break;
+        case Strategy::ATOMIC_BITMASK: acquire_bitmask(id, counters); break;
+        default:
+            // Иерархия: по возрастанию номеров
+            ++counters.attempts;
+            for (int r : graph_.needs[id]) table_->mutexes[r].lock();
+    }
+}
+
+void DrinkingPhilosophers::release(int id) {
+    const auto& needs = graph_.needs[id];
+    switch (strategy_) {
+        case Strategy::ARBITRATOR: {
+            std::lock_guard<std::mutex> lock(table_->table_mutex);
+            for (int r : needs) table_->available[r] = true;
+            break;
+        }
+        case Strategy::WAITER: release_waiter(id); break;
+        case Strategy::ATOMIC_BITMASK: release_bitmask(id); break;
+        default:
+            for (auto r = needs.rbegin(); r != needs.rend(); ++r) table_->mutexes[*r].unlock();
+    }
+}
+
+void DrinkingPhilosophers::acquire_mutex(int id, TaskCounters& counters) {
+    const auto& needs = graph_.needs[id];
+    auto& mutexes = table_->mutexes;
+    size_t k = needs.size();
+
+    // Как std::lock: ждем один ресурс, остальные только пробуем. После
+    // отказа ждем тот, на котором сорвалось, - он и был узким местом
+    size_t first = 0;
+    while (true) {
+        ++counters.attempts;
+        mutexes[needs[first]].lock();
+
+        size_t failed = k;
+        for (size_t j = 0; j < k && failed == k; ++j) {
+            if (j != first && !mutexes[needs[j]].try_lock()) failed = j;
+        }
+        if (failed == k) return;
+
+        for (size_t j = 0; j < failed; ++j) {
+            if (j != first) mutexes[needs[j]].unlock();
+        }
+        mutexes[needs[first]].unlock();
+        ++counters.aborts;
+        first = failed;
+        std::this_thread::yield();
+    }
+}
+
+void DrinkingPhilosophers::acquire_try_lock(int id, std::mt19937& gen, TaskCounters& counters) {
+    const auto& needs = graph_.needs[id];
+    auto& mutexes = table_->mutexes;
+    size_t k = needs.size();
+    long long retry = std::max<long long>(1, workload_.retry.count());
+    std::uniform_int_distribution<long long> retry_dist(retry, 5 * retry);
+
+    while (true) {
+        ++counters.attempts;
+        size_t taken = 0;
+        while (taken < k && mutexes[needs[taken]].try_lock()) ++taken;
+        if (taken == k) return;
+
+        while (taken > 0) mutexes[needs[--taken]].unlock();
+        ++counters.aborts;
+        retry_pause(std::chrono::microseconds(retry_dist(gen)));
+    }
+}
+
+void DrinkingPhilosophers::acquire_arbitrator(int id, TaskCounters& counters) {
+    const auto& needs = graph_.needs[id];
+    ResourceTable& table = *table_;
+
+    while (true) {
+        ++counters.attempts;
+        {
+            std::lock_guard<std::mutex> lock(table.table_mutex);
+            bool all_free = std::all_of(needs.begin(), needs.end(),
+                                        [&](int r) { return table.available[r]; });
+            if (all_free) {
+                for (int r : needs) table.available[r] = false;
+                return;
+            }
+        }
+        ++counters.aborts;
+        retry_pause(workload_.retry);
+    }
+}
+
+void DrinkingPhilosophers::acquire_waiter(int id, TaskCounters& counters) {
+    const auto& needs = graph_.needs[id];
+    ResourceTable& table = *table_;
+
+    ++counters.attempts;
+    std::unique_lock<std::mutex> lock(table.table_mutex);
+    bool all_free = std::all_of(needs.begin(), needs.end(),
+                                [&](int r) { return table.available[r]; });
+    if (all_free) {
+        for (int r : needs) table.available[r] = false;
+    } else {
+        table.waiting[id] = ++table.next_ticket;
+        table.waiter_cvs[id].wait(lock, [&]() { return table.waiting[id] == 0; });
+    }
+}
+
+void DrinkingPhilosophers::release_waiter(int id) {
+    const auto& needs = graph_.needs[id];
+    ResourceTable& table = *table_;
+
+    // Освободились только ресурсы этой задачи: претенденты - ждущие
+    // пользователи этих ресурсов, первым получает дольше ждущий
+    std::vector<int> woken;
+    {
+        std::lock_guard<std::mutex> lock(table.table_mutex);
+        std::vector<int> candidates;
+        for (int r : needs) {
+            table.available[r] = true;
+            for (int user : table.users[r]) {
+                if (table.waiting[user] != 0) candidates.push_back(user);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [&](int a, int b) { return table.waiting[a] < table.waiting[b]; });
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (int task : candidates) {
+            if (table.hand_over(task, graph_.needs[task])) woken.push_back(task);
+        }
+    }
+    for (int task : woken) {
+        table.waiter_cvs[task].notify_one();
+    }
+}
+
+void DrinkingPhilosophers::acquire_bitmask(int id, TaskCounters& counters) {
+    const auto& groups = table_->word_masks[id];
+    auto& words = table_->words;
+
+    // Слова по возрастанию, одно CAS на слово. Занятое слово: уже взятые
+    // слова отпускаются (никто не ждет, держа часть ресурсов), затем
+    // ожидание на занятом слове
+    ++counters.attempts;
+    size_t taken = 0;
+    uint64_t observed;
+    while (taken < groups.size()) {
+        auto [word, mask] = groups[taken];
+        if (try_set_bits(words[word], mask, observed)) {
+            ++taken;
+            continue;
+        }
+        // Откат завершает попытку, следующая начинается после ожидания;
+        // пробуждение без взятых слов продолжает ту же попытку
+        if (taken > 0) {
+            for (size_t j = 0; j < taken; ++j) clear_bits(words[groups[j].first], groups[j].second);
+            taken = 0;
+            ++counters.aborts;
+            ++counters.attempts;
+        }
+        words[word].wait(observed);
+    }
+}
+
+void DrinkingPhilosophers::release_bitmask(int id) {
+    for (auto [word, mask] : table_->word_masks[id]) {
+        clear_bits(table_->words[word], mask);
+    }
+}
+
+void DrinkingPhilosophers::task_loop(int id, int iterations) {
+    TaskCounters& counters = counters_[id];
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    for (int i = 0; i < iterations; ++i) {
+        pass_time(jittered(workload_.think, gen));
+
+        auto hungry_since = Clock::now();
+        acquire(id, gen, counters);
+        int64_t wait = std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - hungry_since).count();
+        counters.total_wait_us += wait;
+        counters.max_wait_us = std::max(counters.max_wait_us, wait);
+
+        pass_time(jittered(workload_.drink, gen));
+        release(id);
+    }
+}
+
+void DrinkingPhilosophers::task_chandy_misra(int id, int iterations) {
+    ResourceTable& table = *table_;
+    const auto& neighbors = table.neighbors[id];
+    const auto& reverse_edge = table.reverse_edge[id];
+    ChandyMisraDrinker self(id, neighbors);
+
+    auto send = [&](size_t e, ChandyMisraMessage::Kind kind) {
+        table.mailboxes[neighbors[e]]->post(DrinkingMessage{kind, reverse_edge[e]});
+    };
+
+    struct Host {
+        const DrinkingPhilosophers& engine;
+        TaskCounters& counters;
+        std::mt19937 gen{std::random_device{}()};
+        Clock::time_point hungry_since{};
+
+        std::chrono::microseconds think_time() { return jittered(engine.workload_.think, gen); }
+        std::chrono::microseconds eat_time() { return jittered(engine.workload_.drink, gen); }
+        void pass_time(std::chrono::microseconds duration) { engine.pass_time(duration); }
+
+        void hungry(int) {
+            hungry_since = Clock::now();
+            ++counters.attempts;
+        }
+        void eating(int) {
+            int64_t wait = std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - hungry_since).count();
+            counters.total_wait_us += wait;
+            counters.max_wait_us = std::max(counters.max_wait_us, wait);
+        }
+        void done(int) {}
+    } host{*this, counters_[id]};
+
+    run_chandy_misra(self, *table.mailboxes[id], send, iterations, workload_.busy_wait, host);
+    counters_[id].reclaims = self.reclaims();
+}
+
+DrinkingStats DrinkingPhilosophers::run(int iterations) {
+    DrinkingStats stats;
+    if (!supports(strategy_)) {
+        std::cerr << "Ошибка: стратегия " << strategy_to_string(strategy_)
+                  << " не обобщается на граф ресурсов\n";
+        return stats;
+    }
+    if (graph_.empty() || iterations < 1) return stats;
+
+    int n = graph_.tasks();
+    table_ = std::make_unique<ResourceTable>(graph_);
+    counters_.assign(n, TaskCounters());
+
+    Benchmark b("Пьющие философы", false);
+    std::vector<std::thread> tasks;
+    for (int id = 0; id < n; ++id) {
+        if (strategy_ == Strategy::CHANDY_MISRA) {
+            tasks.emplace_back(&DrinkingPhilosophers::task_chandy_misra, this, id, iterations);
+        } else {
+            tasks.emplace_back(&DrinkingPhilosophers::task_loop, this, id, iterations);
+        }
+    }
+    for (auto& t : tasks) {
+        t.join();
+    }
+    stats.wall_seconds = b.elapsed_seconds();
+
+    int64_t total_wait = 0, max_wait = 0;
+    for (const TaskCounters& c : counters_) {
+        stats.attempts += c.attempts;
+        stats.aborts += c.aborts;
+        stats.reclaims += c.reclaims;
+        total_wait += c.total_wait_us;
+        max_wait = std::max(max_wait, c.max_wait_us);
+    }
+    stats.meals = static_cast<long long>(n) * iterations;
+    stats.average_wait_ms = total_wait / 1000.0 / stats.meals;
+    stats.max_wait_ms = max_wait / 1000.0;
+
+    table_.reset();
+    return stats;
+}
+
+// Все поддерживаемые стратегии на одном графе: строка таблицы на стратегию
+static void run_graph_strategies(const ResourceGraph& graph, int iterations,
+                                 std::vector<std::pair<std::string, double>>& results) {
+    std::vector<DiningPhilosophers::Strategy> strategies;
+    for (auto strategy : all_strategies()) {
+        if (DrinkingPhilosophers::supports(strategy)) strategies.push_back(strategy);
+    }
+
+    std::cout << "\nГраф: " << graph.name << ", задач " << graph.tasks()
+              << ", ресурсов " << graph.resources << std::fixed << std::setprecision(2)
+              << ", ресурсов на задачу " << graph.average_resources()
+              << ", плотность конфликтов " << graph.conflict_density() << "\n";
+    std::cout << std::setw(22) << "Стратегия"
+              << std::setw(14) << "Трапез/с"
+              << std::setw(18) << "Откатов/трапезу"
+              << std::setw(16) << "Доля откатов"
+              << std::setw(18) << "Отзывов/трапезу"
+              << std::setw(18) << "Ожидание (мс)"
+              << std::setw(14) << "Макс. (мс)" << "\n";
+    std::cout << std::string(120, '-') << std::endl;
+
+    for (auto strategy : strategies) {
+        DrinkingPhilosophers engine(graph, strategy);
+        DrinkingStats stats = engine.run(iterations);
+        std::string name = strategy_to_string(strategy);
+
+        std::cout << std::setw(22) << name
+                  << std::setw(14) << std::setprecision(0) << stats.meals_per_second()
+                  << std::setw(18) << std::setprecision(2) << stats.aborts_per_meal()
+                  << std::setw(16) << stats.abort_rate()
+                  << std::setw(18) << stats.reclaims_per_meal()
+                  << std::setw(18) << stats.average_wait_ms
+                  << std::setw(14) << stats.max_wait_ms << "\n";
+
+        std::string test_name = graph.name + "_" + name;
+        results.emplace_back(test_name + "_трапез_в_с", stats.meals_per_second());
+        results.emplace_back(test_name + "_откатов_на_трапезу", stats.aborts_per_meal());
+        if (strategy == DiningPhilosophers::Strategy::CHANDY_MISRA) {
+            results.emplace_back(test_name + "_отзывов_на_трапезу", stats.reclaims_per_meal());
+        }
+    }
+    std::cout.unsetf(std::ios::fixed);
+}
+
+void run_drinking_benchmark(int iterations) {
+    std::cout << "\n=== Пьющие философы: рост плотности графа ресурсов ===\n";
+    std::cout << "Трапез на задачу: " << iterations << "\n";
+
+    // Случайные графы: 32 задачи на 96 ресурсах (два слова битовой маски),
+    // k ресурсов на задачу
+    std::vector<ResourceGraph> graphs = {ring_graph(32), grid_graph(4, 8)};
+    for (int k : {2, 4, 8, 16}) {
+        graphs.push_back(random_graph(32, 96, k, 26 + k));
+    }
+
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    for (const ResourceGraph& graph : graphs) {
+        run_graph_strategies(graph, iterations, benchmark_results);
+    }
+
+    Benchmark::save_to_csv(benchmark_results, "philosophers_drinking_benchmark.csv");
+}
+
+void run_drinking_philosophers() {
+    std::cout << "\n=== Пьющие философы: общий граф задач и ресурсов ===\n";
+
+    int choice, iterations;
+    std::cout << "1. Прогон по плотности графа (кольцо, решетка, случайные графы)\n";
+    std::cout << "2. Граф из файла\n";
+    std::cout << "Ваш выбор: ";
+    std::cin >> choice;
+
+    if (choice == 2) {
+        std::string path;
+        std::cout << "Путь к файлу графа: ";
+        std::cin >> path;
+
+        ResourceGraph graph = load_resource_graph(path);
+        if (graph.empty()) return;
+
+        std::cout << "Введите количество трапез на задачу (5-200): ";
+        std::cin >> iterations;
+        if (iterations < 5) iterations = 5;
+        if (iterations > 200) iterations = 200;
+
+        std::vector<std::pair<std::string, double>> results;
+        run_graph_strategies(graph, iterations, results);
+        Benchmark::save_to_csv(results, "philosophers_drinking_graph.csv");
+        return;
+    }
+
+    std::cout << "Введите количество трапез на задачу (5-200): ";
+    std::cin >> iterations;
+    if (iterations < 5) iterations = 5;
+    if (iterations > 200) iterations = 200;
+    run_drinking_benchmark(iterations);
+}
+
+} // namespace task3
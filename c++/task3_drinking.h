@@ -0,0 +1,143 @@
+#ifndef TASK3_DRINKING_H
+#define TASK3_DRINKING_H
+
+#include "task3_philosophers.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace task3 {
+
+// Двудольный граф задача -> ресурсы. Кольцо философов - частный случай:
+// задача i берет ресурсы i и (i+1) % n.
+struct ResourceGraph {
+    std::string name;
+    int resources = 0;
+    std::vector<std::vector<int>> needs;   // ресурсы задачи: по возрастанию, без повторов
+
+    int tasks() const { return static_cast<int>(needs.size()); }
+    bool empty() const { return needs.empty(); }
+
+    // Задачи каждого ресурса
+    std::vector<std::vector<int>> users() const;
+    // Граф конфликтов: соседи задачи - задачи с общим ресурсом, по возрастанию
+    std::vector<std::vector<int>> conflicts() const;
+
+    double average_resources() const;
+    // Доля пар задач, которые конфликтуют (плотность графа конфликтов)
+    double conflict_density() const;
+};
+
+ResourceGraph ring_graph(int tasks);
+// Каждая задача берет per_task различных ресурсов из resources
+ResourceGraph random_graph(int tasks, int resources, int per_task, uint32_t seed);
+// Задачи - клетки rows x cols, ресурсы - узлы решетки: клетке нужны
+// 4 угла, соседние клетки делят 2 угла, диагональные - 1
+ResourceGraph grid_graph(int rows, int cols);
+// Текстовый файл: число ресурсов, затем по строке на задачу с номерами
+// ее ресурсов; пустые строки и строки с '#' пропускаются. При ошибке -
+// пустой граф и сообщение в std::cerr
+ResourceGraph load_resource_graph(const std::string& path);
+
+// Размышление и питье задач. Паузы короче, чем у кольца: прогон по
+// плотностям графа должен занимать секунды
+struct DrinkingWorkload {
+    std::chrono::microseconds think{200};
+    std::chrono::microseconds drink{500};
+    std::chrono::microseconds retry{50};    // пауза после отказа
+    bool busy_wait = false;                 // busy_work вместо sleep_for
+};
+
+// Итоги прогона. Попытка - одна попытка взять весь набор ресурсов,
+// которая заканчивается трапезой или откатом (отпущена часть ресурсов,
+// отказ арбитра); ожидание без удерживаемых ресурсов попыткой не считается.
+// Поэтому attempts = meals + aborts во всех стратегиях и abort_rate <= 1.
+struct DrinkingStats {
+    long long meals = 0;
+    long long attempts = 0;
+    long long aborts = 0;
+    long long reclaims = 0;     // Чанди-Мисра: голодная задача отдала вилку и просит снова
+    double wall_seconds = 0.0;
+    double average_wait_ms = 0.0;
+    double max_wait_ms = 0.0;
+
+    double meals_per_second() const { return wall_seconds > 0.0 ? meals / wall_seconds : 0.0; }
+    double aborts_per_meal() const { return meals > 0 ? static_cast<double>(aborts) / meals : 0.0; }
+    double reclaims_per_meal() const { return meals > 0 ? static_cast<double>(reclaims) / meals : 0.0; }
+    double abort_rate() const { return attempts > 0 ? static_cast<double>(aborts) / attempts : 0.0; }
+};
+
+// Стратегии обедающих философов, обобщенные на k ресурсов из многих:
+//   MUTEX              - как std::lock: блокирующий захват одного ресурса,
+//                        try_lock остальных, при отказе откат и старт с
+//                        ресурса, на котором сорвалось
+//   TRY_LOCK           - try_lock всех, при отказе откат и случайная пауза
+//   ARBITRATOR         - общий мьютекс и опрос занятости всех ресурсов
+//   RESOURCE_HIERARCHY - блокирующий захват по возрастанию номеров
+//   WAITER             - общий мьютекс и очередь: освобождающий отдает
+//                        ресурсы ждущим задачам в порядке очереди
+//   CHANDY_MISRA       - вилка на каждую пару конфликтующих задач
+//   ATOMIC_BITMASK     - ресурсы - биты слов, по одному CAS на слово в
+//                        порядке возрастания; откат, если слово занято
+// SEMAPHORE (левая, затем правая без порядка) на общий граф не
+// обобщается без взаимной блокировки и не поддерживается.
+class DrinkingPhilosophers {
+public:
+    using Strategy = DiningPhilosophers::Strategy;
+
+    DrinkingPhilosophers(ResourceGraph graph, Strategy strategy,
+                         DrinkingWorkload workload = DrinkingWorkload());
+    ~DrinkingPhilosophers();
+
+    DrinkingPhilosophers(const DrinkingPhilosophers&) = delete;
+    DrinkingPhilosophers& operator=(const DrinkingPhilosophers&) = delete;
+
+    static bool supports(Strategy strategy);
+
+    // Поток на задачу, iterations трапез каждой
+    DrinkingStats run(int iterations);
+
+private:
+    struct ResourceTable;
+
+    // Счетчики задачи пишет только ее поток
+    struct alignas(kCacheLineSize) TaskCounters {
+        long long attempts = 0;
+        long long aborts = 0;
+        long long reclaims = 0;
+        int64_t total_wait_us = 0;
+        int64_t max_wait_us = 0;
+    };
+
+    ResourceGraph graph_;
+    Strategy strategy_;
+    DrinkingWorkload workload_;
+    std::unique_ptr<ResourceTable> table_;
+    std::vector<TaskCounters> counters_;
+
+    void task_loop(int id, int iterations);
+    void task_chandy_misra(int id, int iterations);
+
+    void acquire(int id, std::mt19937& gen, TaskCounters& counters);
+    void release(int id);
+
+    void acquire_mutex(int id, TaskCounters& counters);
+    void acquire_try_lock(int id, std::mt19937& gen, TaskCounters& counters);
+    void acquire_arbitrator(int id, TaskCounters& counters);
+    void acquire_waiter(int id, TaskCounters& counters);
+    void acquire_bitmask(int id, TaskCounters& counters);
+    void release_waiter(int id);
+    void release_bitmask(int id);
+
+    void pass_time(std::chrono::microseconds duration) const;
+    void retry_pause(std::chrono::microseconds duration) const;
+};
+
+void run_drinking_philosophers();
+void run_drinking_benchmark(int iterations);
+
+} // namespace task3
+
+#endif // TASK3_DRINKING_H
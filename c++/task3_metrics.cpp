@@ -0,0 +1,224 @@
+#include "task3_metrics.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace task3 {
+
+namespace {
+
+int bucket_of(int64_t wait_us) {
+    int bucket = 0;
+    while (wait_us > 0 && bucket < kWaitBuckets - 1) {
+        wait_us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Точный процентиль по рангу: ожидание, которое не превышают q всех
+// трапез. Прогоны с метриками - сотни трапез на философа, сортировка копии
+// дешевле любой точной гистограммы
+double sample_percentile_ms(std::vector<int64_t> samples, double q) {
+    if (samples.empty()) return 0.0;
+
+    size_t rank = static_cast<size_t>(q * samples.size());
+    if (rank >= samples.size()) rank = samples.size() - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank] / 1000.0;
+}
+
+} // namespace
+
+double PhilosopherStats::bucket_upper_ms(int bucket) {
+    return static_cast<double>(1LL << bucket) / 1000.0;
+}
+
+double PhilosopherStats::wait_percentile_ms(double q) const {
+    return sample_percentile_ms(wait_samples_us, q);
+}
+
+double TableMetrics::concurrency_efficiency() const {
+    return max_concurrency() > 0 ? average_eaters / max_concurrency() : 0.0;
+}
+
+double TableMetrics::average_wait_ms() const {
+    double total = 0.0;
+    long long meals = 0;
+    for (const auto& p : per_philosopher) {
+        total += p.average_wait_ms * p.meals;
+        meals += p.meals;
+    }
+    return meals > 0 ? total / meals : 0.0;
+}
+
+double TableMetrics::max_wait_ms() const {
+    double result = 0.0;
+    for (const auto& p : per_philosopher) result = std::max(result, p.max_wait_ms);
+    return result;
+}
+
+double TableMetrics::wait_percentile_ms(double q) const {
+    std::vector<int64_t> samples;
+    for (const auto& p : per_philosopher) {
+        samples.insert(samples.end(), p.wait_samples_us.begin(), p.wait_samples_us.end());
+    }
+    return sample_percentile_ms(std::move(samples), q);
+}
+
+double TableMetrics::average_fork_utilization() const {
+    if (fork_utilization.empty()) return 0.0;
+    double total = 0.0;
+    for (double u : fork_utilization) total += u;
+    return total / fork_utilization.size();
+}
+
+long long TableMetrics::total_retries() const {
+    long long total = 0;
+    for (const auto& p : per_philosopher) total += p.retries;
+    return total;
+}
+
+PhilosopherMetrics::PhilosopherMetrics(int num_philosophers, int iterations)
+    : n_(num_philosophers), iterations_(iterations), start_(Clock::now()),
+      slots_(num_philosophers), forks_(num_philosophers) {
+    for (Slot& slot : slots_) {
+        slot.waits.reserve(std::max(0, iterations));
+    }
+}
+
+int64_t PhilosopherMetrics::now_us() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_).count();
+}
+
+void PhilosopherMetrics::hungry(int id) {
+    slots_[id].hungry_since = now_us();
+}
+
+void PhilosopherMetrics::fork_taken(int fork) {
+    forks_[fork].taken_at = now_us();
+}
+
+void PhilosopherMetrics::eating(int id, int left_fork, int right_fork) {
+    int64_t now = now_us();
+    Slot& slot = slots_[id];
+
+    int64_t wait = now - slot.hungry_since;
+    slot.total_wait += wait;
+    slot.max_wait = std::max(slot.max_wait, wait);
+    slot.histogram[bucket_of(wait)]++;
+    slot.waits.push_back(wait);
+    slot.eating_since = now;
+
+    for (int fork : {left_fork, right_fork}) {
+        if (forks_[fork].taken_at < 0) forks_[fork].taken_at = now;
+    }
+
+    int eaters = eaters_.fetch_add(1, std::memory_order_relaxed) + 1;
+    int prev = max_eaters_.load(std::memory_order_relaxed);
+    while (prev < eaters && !max_eaters_.compare_exchange_weak(prev, eaters, std::memory_order_relaxed)) {}
+}
+
+void PhilosopherMetrics::done_eating(int id, int left_fork, int right_fork) {
+    int64_t now = now_us();
+    Slot& slot = slots_[id];
+    slot.total_eating += now - slot.eating_since;
+    eaters_.fetch_sub(1, std::memory_order_relaxed);
+
+    // Вызывается до возврата вилок: следующий держатель увидит taken_at = -1
+    for (int fork : {left_fork, right_fork}) {
+        forks_[fork].busy += now - forks_[fork].taken_at;
+        forks_[fork].taken_at = -1;
+    }
+
+    long long meals = slot.meals.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    // Первый наевшийся делает срез трапез всех философов
+    if (meals == iterations_ && !first_finished_.exchange(true)) {
+        for (Slot& other : slots_) {
+            other.meals_at_first_finish = other.meals.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void PhilosopherMetrics::retry(int id) {
+    slots_[id].retries++;
+}
+
+TableMetrics PhilosopherMetrics::report() const {
+    TableMetrics metrics;
+    metrics.philosophers = n_;
+    metrics.wall_seconds = now_us() / 1e6;
+    double wall_us = std::max<int64_t>(1, now_us());
+
+    double total_eating = 0.0;
+    double sum = 0.0, sum_squares = 0.0;
+    for (const Slot& slot : slots_) {
+        PhilosopherStats p;
+        p.meals = slot.meals.load(std::memory_order_relaxed);
+        p.meals_at_first_finish = slot.meals_at_first_finish < 0 ? p.meals : slot.meals_at_first_finish;
+        p.average_wait_ms = p.meals > 0 ? slot.total_wait / 1000.0 / p.meals : 0.0;
+        p.max_wait_ms = slot.max_wait / 1000.0;
+        p.retries = slot.retries;
+        p.wait_histogram = slot.histogram;
+        p.wait_samples_us = slot.waits;
+        metrics.per_philosopher.push_back(p);
+
+        total_eating += slot.total_eating;
+        sum += p.meals_at_first_finish;
+        sum_squares += static_cast<double>(p.meals_at_first_finish) * p.meals_at_first_finish;
+    }
+
+    for (const ForkSlot& fork : forks_) {
+        metrics.fork_utilization.push_back(fork.busy / wall_us);
+    }
+
+    metrics.average_eaters = total_eating / wall_us;
+    metrics.max_eaters = max_eaters_.load();
+    metrics.fairness = sum_squares > 0.0 ? sum * sum / (n_ * sum_squares) : 1.0;
+    return metrics;
+}
+
+void save_metrics_csv(const std::vector<std::pair<std::string, TableMetrics>>& runs,
+                      const std::string& summary_file,
+                      const std::string& histogram_file) {
+    std::ofstream summary(summary_file);
+    std::ofstream histograms(histogram_file);
+    if (!summary.is_open() || !histograms.is_open()) {
+        std::cerr << "Ошибка: не удалось создать файлы " << summary_file
+                  << " и " << histogram_file << std::endl;
+        return;
+    }
+
+    summary << "Стратегия,Философов,Время(с),Ожидание(мс),p50(мс),p99(мс),"
+               "Макс.голодание(мс),Справедливость,Едящих в среднем,Едящих макс.,"
+               "Предел n/2,Эффективность,Занятость вилок,Повторов\n";
+    histograms << "Стратегия,Философов,Философ,Трапез,Трапез к первому финишу,"
+                  "Ожидание(мс),Макс.(мс)";
+    for (int k = 0; k < kWaitBuckets; ++k) {
+        histograms << ",<" << PhilosopherStats::bucket_upper_ms(k) << "мс";
+    }
+    histograms << "\n";
+
+    for (const auto& [strategy, m] : runs) {
+        summary << strategy << "," << m.philosophers << "," << m.wall_seconds << ","
+                << m.average_wait_ms() << "," << m.wait_percentile_ms(0.5) << ","
+                << m.wait_percentile_ms(0.99) << "," << m.max_wait_ms() << ","
+                << m.fairness << "," << m.average_eaters << "," << m.max_eaters << ","
+                << m.max_concurrency() << "," << m.concurrency_efficiency() << ","
+                << m.average_fork_utilization() << "," << m.total_retries() << "\n";
+
+        for (size_t id = 0; id < m.per_philosopher.size(); ++id) {
+            const PhilosopherStats& p = m.per_philosopher[id];
+            histograms << strategy << "," << m.philosophers << "," << id << ","
+                       << p.meals << "," << p.meals_at_first_finish << ","
+                       << p.average_wait_ms << "," << p.max_wait_ms;
+            for (long long count : p.wait_histogram) histograms << "," << count;
+            histograms << "\n";
+        }
+    }
+
+    std::cout << "Метрики сохранены в файлы: " << summary_file << ", " << histogram_file << std::endl;
+}
+
+} // namespace task3
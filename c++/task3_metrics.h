@@ -0,0 +1,116 @@
+#ifndef TASK3_METRICS_H
+#define TASK3_METRICS_H
+
+#include "thread_pool.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace task3 {
+
+// Корзины гистограммы ожидания: корзина k - ожидание в [2^(k-1), 2^k) мкс,
+// корзина 0 - меньше 1 мкс, последняя - все остальное. Гистограмма идет
+// только в CSV; процентили считаются точно по записанным ожиданиям.
+constexpr int kWaitBuckets = 25;
+
+// Итоги одного философа
+struct PhilosopherStats {
+    long long meals = 0;
+    long long meals_at_first_finish = 0;  // к моменту, когда первый наелся
+    double average_wait_ms = 0.0;         // от голода до начала еды
+    double max_wait_ms = 0.0;             // самое долгое голодание
+    long long retries = 0;                // неудачных попыток взять вилки
+    std::array<long long, kWaitBuckets> wait_histogram{};
+    std::vector<int64_t> wait_samples_us;  // ожидание каждой трапезы
+
+    // Верхняя граница корзины в миллисекундах
+    static double bucket_upper_ms(int bucket);
+    double wait_percentile_ms(double q) const;
+};
+
+// Итоги стола
+struct TableMetrics {
+    int philosophers = 0;
+    double wall_seconds = 0.0;
+    std::vector<PhilosopherStats> per_philosopher;
+    std::vector<double> fork_utilization;  // доля времени, когда вилка занята
+    double average_eaters = 0.0;           // среднее число едящих одновременно
+    int max_eaters = 0;
+    double fairness = 1.0;                 // индекс Джайна по meals_at_first_finish
+
+    // Теоретический предел одновременно едящих - floor(n/2)
+    int max_concurrency() const { return philosophers / 2; }
+    double concurrency_efficiency() const;
+    double average_wait_ms() const;
+    double max_wait_ms() const;
+    double wait_percentile_ms(double q) const;
+    double average_fork_utilization() const;
+    long long total_retries() const;
+};
+
+// Сбор метрик во время прогона потоков. У каждого философа и каждой вилки
+// своя кэш-линия; пишет в нее только текущий владелец (философ или
+// держатель вилки), поэтому счетчики обычные, кроме числа трапез - его
+// читают другие потоки для среза справедливости.
+class PhilosopherMetrics {
+public:
+    PhilosopherMetrics(int num_philosophers, int iterations);
+
+    PhilosopherMetrics(const PhilosopherMetrics&) = delete;
+    PhilosopherMetrics& operator=(const PhilosopherMetrics&) = delete;
+
+    void hungry(int id);
+    // Отдельно взятая вилка (стратегии, которые ждут вторую, держа первую)
+    void fork_taken(int fork);
+    // Обе вилки у философа: конец ожидания, начало еды
+    void eating(int id, int left_fork, int right_fork);
+    void done_eating(int id, int left_fork, int right_fork);
+    // Неудачная попытка: вилки не взяты, будет пауза и повтор
+    void retry(int id);
+
+    TableMetrics report() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    int64_t now_us() const;
+
+    struct alignas(kCacheLineSize) Slot {
+        int64_t hungry_since = 0;
+        int64_t eating_since = 0;
+        int64_t total_wait = 0;
+        int64_t max_wait = 0;
+        int64_t total_eating = 0;
+        long long retries = 0;
+        std::atomic<long long> meals{0};
+        long long meals_at_first_finish = -1;
+        std::array<long long, kWaitBuckets> histogram{};
+        std::vector<int64_t> waits;   // место под все трапезы выделено заранее
+    };
+
+    struct alignas(kCacheLineSize) ForkSlot {
+        int64_t taken_at = -1;
+        int64_t busy = 0;
+    };
+
+    int n_;
+    int iterations_;
+    Clock::time_point start_;
+    std::vector<Slot> slots_;
+    std::vector<ForkSlot> forks_;
+    std::atomic<int> eaters_{0};
+    std::atomic<int> max_eaters_{0};
+    std::atomic<bool> first_finished_{false};
+};
+
+// Сводка (стратегия, философов) и гистограммы по философам
+void save_metrics_csv(const std::vector<std::pair<std::string, TableMetrics>>& runs,
+                      const std::string& summary_file,
+                      const std::string& histogram_file);
+
+} // namespace task3
+
+#endif // TASK3_METRICS_H
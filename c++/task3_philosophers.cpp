@@ -1,5 +1,10 @@
 #include "task3_philosophers.h"
+#include "task3_simulation.h"
+#include "task3_coroutines.h"
+#include "task3_chandy_misra.h"
+#include "task3_drinking.h"
 #include "benchmark_utils.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <thread>
 #include <vector>
@@ -9,6 +14,7 @@
 #include <algorithm>
 #include <iomanip>
 #include <condition_variable>
+#include <atomic>
 
 using namespace std::chrono_literals;
 
@@ -39,23 +45,225 @@ public:
     }
 };
 
-DiningPhilosophers::DiningPhilosophers(int num_philosophers, Strategy strategy)
-    : num_philosophers_(num_philosophers), strategy_(strategy) {}
+bool try_set_bits(std::atomic<uint64_t>& word, uint64_t mask, uint64_t& observed) {
+    observed = word.load(std::memory_order_relaxed);
+    while ((observed & mask) == 0) {
+        if (word.compare_exchange_weak(observed, observed | mask,
+                                       std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Освобождение будит ждущих на слове (atomic::wait - фьютекс по адресу)
+void clear_bits(std::atomic<uint64_t>& word, uint64_t mask) {
+    word.fetch_and(~mask, std::memory_order_release);
+    word.notify_all();
+}
+
+// Занятость без обращения к часам: цепочка зависимых умножений, которую
+// компилятор не может свернуть, результат уходит в volatile (у каждого
+// потока свой - без гонки и без общей кэш-линии)
+static thread_local volatile uint64_t spin_sink;
+
+static void spin_iterations(long long iterations) {
+    uint64_t x = spin_sink;
+    for (long long i = 0; i < iterations; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    spin_sink = x;
+}
+
+// Итераций на наносекунду: меряется один раз, лучший из нескольких
+// замеров (худшие могли прерваться вытеснением потока)
+static double spin_iterations_per_ns() {
+    static const double rate = []() {
+        using Clock = std::chrono::steady_clock;
+        const long long iterations = 2000000;
+        double best_ns = 0.0;
+        for (int attempt = 0; attempt < 5; ++attempt) {
+            auto start = Clock::now();
+            spin_iterations(iterations);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            if (best_ns == 0.0 || ns < best_ns) best_ns = ns;
+        }
+        return best_ns > 0.0 ? iterations / best_ns : 1.0;
+    }();
+    return rate;
+}
+
+void busy_work(std::chrono::nanoseconds duration) {
+    spin_iterations(static_cast<long long>(duration.count() * spin_iterations_per_ns()));
+}
+
+std::string backoff_to_string(const BackoffPolicy& policy) {
+    std::string name;
+    switch (policy.kind) {
+        case BackoffPolicy::Kind::UNIFORM: name = "Равномерная"; break;
+        case BackoffPolicy::Kind::EXPONENTIAL: name = "Экспоненциальная"; break;
+        case BackoffPolicy::Kind::DECORRELATED_JITTER: name = "Декоррелированная"; break;
+    }
+    name += " " + std::to_string(policy.base.count() / 1000) + "-" +
+            std::to_string(policy.cap.count() / 1000) + " мс";
+    if (policy.spin_attempts > 0) {
+        name += " + " + std::to_string(policy.spin_attempts) + " вращ.";
+    }
+    return name;
+}
+
+Backoff::Delay Backoff::next(std::mt19937& gen) {
+    return next_delay(gen);
+}
+
+Backoff::Delay Backoff::next(std::minstd_rand& gen) {
+    return next_delay(gen);
+}
+
+template <typename Generator>
+Backoff::Delay Backoff::next_delay(Generator& gen) {
+    int attempt = failures_++;
+    if (attempt < policy_.spin_attempts) {
+        return {std::chrono::microseconds(1LL << std::min(attempt, 20)), true};
+    }
+    attempt -= policy_.spin_attempts;
+    
+    long long base = std::max<long long>(1, policy_.base.count());
+    long long cap = std::max(base, static_cast<long long>(policy_.cap.count()));
+    long long us = base;
+    switch (policy_.kind) {
+        case BackoffPolicy::Kind::UNIFORM: {
+            std::uniform_int_distribution<long long> dist(base, cap);
+            us = dist(gen);
+            break;
+        }
+        case BackoffPolicy::Kind::EXPONENTIAL: {
+            long long ceiling = std::min(cap, base << std::min(attempt, 30));
+            std::uniform_int_distribution<long long> dist(0, ceiling);
+            us = dist(gen);
+            break;
+        }
+        case BackoffPolicy::Kind::DECORRELATED_JITTER: {
+            std::uniform_int_distribution<long long> dist(base, std::max(base, previous_us_ * 3));
+            us = std::min(cap, dist(gen));
+            break;
+        }
+    }
+    previous_us_ = us;
+    return {std::chrono::microseconds(us), false};
+}
+
+struct DiningPhilosophers::ForkTable {
+    explicit ForkTable(int n)
+        : mutexes(n), semaphores(n), available(n, true), waiter_cvs(n), waiting(n, 0),
+          fork_bits((n + 63) / 64) {
+        for (int i = 0; i < n; ++i) {
+            mailboxes.push_back(std::make_unique<ChandyMisraMailbox>());
+        }
+    }
+    
+    std::vector<std::mutex> mutexes;          // мьютексы, try_lock, иерархия
+    std::vector<BinarySemaphore> semaphores;
+    std::mutex table_mutex;                   // арбитр и официант
+    std::vector<bool> available;
+    
+    // Официант: ожидающий философ спит на своей переменной условия,
+    // waiting[id] - номер его очереди (0 - не ждет)
+    std::vector<std::condition_variable> waiter_cvs;
+    std::vector<uint64_t> waiting;
+    uint64_t next_ticket = 0;
+    
+    // Чанди-Мисра: вилки не лежат на столе, есть только почтовые ящики
+    std::vector<std::unique_ptr<ChandyMisraMailbox>> mailboxes;
+    
+    // Битовая маска: бит f % 64 слова f / 64 - вилка f занята
+    std::vector<std::atomic<uint64_t>> fork_bits;
+    
+    // Под table_mutex: отдать философу p обе вилки, если он ждет и они свободны
+    bool hand_over(int p) {
+        int n = static_cast<int>(available.size());
+        int left = p, right = (p + 1) % n;
+        if (waiting[p] == 0 || !available[left] || !available[right]) return false;
+        available[left] = false;
+        available[right] = false;
+        waiting[p] = 0;
+        return true;
+    }
+};
+
+DiningPhilosophers::DiningPhilosophers(int num_philosophers, Strategy strategy, ExecutionMode mode)
+    : num_philosophers_(num_philosophers), strategy_(strategy), mode_(mode) {}
+
+DiningPhilosophers::~DiningPhilosophers() = default;
+
+void DiningPhilosophers::set_workload(const Workload& workload) {
+    workload_ = workload;
+    // Калибровка до старта потоков, а не в первой трапезе
+    if (workload_.busy_wait) spin_iterations_per_ns();
+}
+
+std::chrono::nanoseconds DiningPhilosophers::think_time(std::mt19937& gen) const {
+    if (workload_.busy_wait) return std::chrono::nanoseconds(workload_.think_ns);
+    std::uniform_int_distribution<> dist(50, 200);
+    return std::chrono::milliseconds(dist(gen));
+}
+
+std::chrono::nanoseconds DiningPhilosophers::eat_time(std::mt19937& gen) const {
+    if (workload_.busy_wait) return std::chrono::nanoseconds(workload_.eat_ns);
+    std::uniform_int_distribution<> dist(100, 300);
+    return std::chrono::milliseconds(dist(gen));
+}
+
+void DiningPhilosophers::pass_time(std::chrono::nanoseconds duration) const {
+    if (workload_.busy_wait) {
+        busy_work(duration);
+    } else {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+void DiningPhilosophers::retry_pause(std::chrono::nanoseconds duration) const {
+    if (workload_.busy_wait) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+// Точки замера: без run_with_metrics только проверка указателя
+void DiningPhilosophers::note_hungry(int id) {
+    if (metrics_) metrics_->hungry(id);
+}
+
+void DiningPhilosophers::note_fork(int fork) {
+    if (metrics_) metrics_->fork_taken(fork);
+}
+
+void DiningPhilosophers::note_eating(int id) {
+    if (metrics_) metrics_->eating(id, id, (id + 1) % num_philosophers_);
+}
+
+void DiningPhilosophers::note_done(int id) {
+    if (metrics_) metrics_->done_eating(id, id, (id + 1) % num_philosophers_);
+}
+
+void DiningPhilosophers::note_retry(int id) {
+    if (metrics_) metrics_->retry(id);
+}
 
 void DiningPhilosophers::philosopher_mutex(int id, int iterations, bool verbose) {
-    static std::vector<std::mutex> forks(num_philosophers_);
+    auto& forks = forks_->mutexes;
     
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> think_dist(50, 200);
-    std::uniform_int_distribution<> eat_dist(100, 300);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
     
     for (int i = 0; i < iterations; ++i) {
         // Размышление
-        std::this_thread::sleep_for(std::chrono::milliseconds(think_dist(gen)));
+        pass_time(think_time(gen));
+        note_hungry(id);
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " размышляет (итерация " << i + 1 << ")\n";
@@ -64,18 +272,23 @@ void DiningPhilosophers::philosopher_mutex(int id, int iterations, bool verbose)
         // Захват вилок в определенном порядке для избежания deadlock
         if (id % 2 == 0) {
             forks[left_fork].lock();
+            note_fork(left_fork);
             forks[right_fork].lock();
         } else {
             forks[right_fork].lock();
+            note_fork(right_fork);
             forks[left_fork].lock();
         }
         
+        note_eating(id);
+        
         // Еда
-        std::this_thread::sleep_for(std::chrono::milliseconds(eat_dist(gen)));
+        pass_time(eat_time(gen));
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " ест спагетти (итерация " << i + 1 << ")\n";
         }
+        note_done(id);
         
         // Освобождение вилок
         forks[left_fork].unlock();
@@ -84,19 +297,18 @@ void DiningPhilosophers::philosopher_mutex(int id, int iterations, bool verbose)
 }
 
 void DiningPhilosophers::philosopher_semaphore(int id, int iterations, bool verbose) {
-    static std::vector<BinarySemaphore> forks(num_philosophers_);
+    auto& forks = forks_->semaphores;
     
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> think_dist(50, 200);
-    std::uniform_int_distribution<> eat_dist(100, 300);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
     
     for (int i = 0; i < iterations; ++i) {
         // Размышление
-        std::this_thread::sleep_for(std::chrono::milliseconds(think_dist(gen)));
+        pass_time(think_time(gen));
+        note_hungry(id);
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " размышляет (итерация " << i + 1 << ")\n";
@@ -104,14 +316,18 @@ void DiningPhilosophers::philosopher_semaphore(int id, int iterations, bool verb
         
         // Захват вилок
         forks[left_fork].acquire();
+        note_fork(left_fork);
         forks[right_fork].acquire();
         
+        note_eating(id);
+        
         // Еда
-        std::this_thread::sleep_for(std::chrono::milliseconds(eat_dist(gen)));
+        pass_time(eat_time(gen));
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " ест спагетти (итерация " << i + 1 << ")\n";
         }
+        note_done(id);
         
         // Освобождение вилок
         forks[left_fork].release();
@@ -120,26 +336,25 @@ void DiningPhilosophers::philosopher_semaphore(int id, int iterations, bool verb
 }
 
 void DiningPhilosophers::philosopher_try_lock(int id, int iterations, bool verbose) {
-    static std::vector<std::mutex> forks(num_philosophers_);
+    auto& forks = forks_->mutexes;
     
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> think_dist(50, 200);
-    std::uniform_int_distribution<> eat_dist(100, 300);
-    std::uniform_int_distribution<> retry_dist(10, 50);
-    
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
     
     for (int i = 0; i < iterations; ++i) {
         // Размышление
-        std::this_thread::sleep_for(std::chrono::milliseconds(think_dist(gen)));
+        pass_time(think_time(gen));
+        note_hungry(id);
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " размышляет (итерация " << i + 1 << ")\n";
         }
         
-        // Попытка захвата вилок с повторными попытками
+        // Попытка захвата вилок с повторными попытками; паузы между
+        // ними задает политика отсрочки
+        Backoff backoff(backoff_);
         bool has_forks = false;
         while (!has_forks) {
             if (forks[left_fork].try_lock()) {
@@ -147,19 +362,29 @@ void DiningPhilosophers::philosopher_try_lock(int id, int iterations, bool verbo
                     has_forks = true;
                 } else {
                     forks[left_fork].unlock();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(retry_dist(gen)));
                 }
-            } else {
-                std::this_thread::sleep_for(std::chrono::milliseconds(retry_dist(gen)));
+            }
+            
+            if (!has_forks) {
+                note_retry(id);
+                Backoff::Delay delay = backoff.next(gen);
+                if (delay.spin) {
+                    busy_work(delay.duration);
+                } else {
+                    retry_pause(delay.duration);
+                }
             }
         }
         
+        note_eating(id);
+        
         // Еда
-        std::this_thread::sleep_for(std::chrono::milliseconds(eat_dist(gen)));
+        pass_time(eat_time(gen));
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " ест спагетти (итерация " << i + 1 << ")\n";
         }
+        note_done(id);
         
         // Освобождение вилок
         forks[left_fork].unlock();
@@ -168,20 +393,19 @@ void DiningPhilosophers::philosopher_try_lock(int id, int iterations, bool verbo
 }
 
 void DiningPhilosophers::philosopher_arbitrator(int id, int iterations, bool verbose) {
-    static std::mutex table_mutex;
-    static std::vector<bool> forks_available(num_philosophers_, true);
+    std::mutex& table_mutex = forks_->table_mutex;
+    std::vector<bool>& forks_available = forks_->available;
     
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> think_dist(50, 200);
-    std::uniform_int_distribution<> eat_dist(100, 300);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
     
     for (int i = 0; i < iterations; ++i) {
         // Размышление
-        std::this_thread::sleep_for(std::chrono::milliseconds(think_dist(gen)));
+        pass_time(think_time(gen));
+        note_hungry(id);
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " размышляет (итерация " << i + 1 << ")\n";
@@ -200,16 +424,20 @@ void DiningPhilosophers::philosopher_arbitrator(int id, int iterations, bool ver
             
             if (!has_permission) {
                 lock.unlock();
-                std::this_thread::sleep_for(10ms);
+                note_retry(id);
+                retry_pause(10ms);
             }
         }
         
+        note_eating(id);
+        
         // Еда
-        std::this_thread::sleep_for(std::chrono::milliseconds(eat_dist(gen)));
+        pass_time(eat_time(gen));
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " ест спагетти (итерация " << i + 1 << ")\n";
         }
+        note_done(id);
         
         // Возврат вилок
         {
@@ -220,13 +448,181 @@ void DiningPhilosophers::philosopher_arbitrator(int id, int iterations, bool ver
     }
 }
 
+void DiningPhilosophers::philosopher_waiter(int id, int iterations, bool verbose) {
+    ForkTable& table = *forks_;
+    
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    
+    int left_fork = id;
+    int right_fork = (id + 1) % num_philosophers_;
+    int left_neighbor = (id + num_philosophers_ - 1) % num_philosophers_;
+    int right_neighbor = right_fork;
+    
+    for (int i = 0; i < iterations; ++i) {
+        // Размышление
+        pass_time(think_time(gen));
+        note_hungry(id);
+        
+        if (verbose && i < 10) {
+            std::cout << "Философ " << id << " размышляет (итерация " << i + 1 << ")\n";
+        }
+        
+        // Свободные вилки берутся сразу, иначе философ встает в очередь
+        // и спит, пока официант не передаст ему обе вилки
+        {
+            std::unique_lock<std::mutex> lock(table.table_mutex);
+            if (table.available[left_fork] && table.available[right_fork]) {
+                table.available[left_fork] = false;
+                table.available[right_fork] = false;
+            } else {
+                table.waiting[id] = ++table.next_ticket;
+                table.waiter_cvs[id].wait(lock, [&]() { return table.waiting[id] == 0; });
+            }
+        }
+        
+        note_eating(id);
+        
+        // Еда
+        pass_time(eat_time(gen));
+        
+        if (verbose && i < 10) {
+            std::cout << "Философ " << id << " ест спагетти (итерация " << i + 1 << ")\n";
+        }
+        note_done(id);
+        
+        // Возврат вилок: освободились только вилки соседей, первым получает
+        // тот, кто дольше ждет
+        int woken[2];
+        int num_woken = 0;
+        {
+            std::lock_guard<std::mutex> lock(table.table_mutex);
+            table.available[left_fork] = true;
+            table.available[right_fork] = true;
+            
+            int first = left_neighbor, second = right_neighbor;
+            if (table.waiting[second] != 0 &&
+                (table.waiting[first] == 0 || table.waiting[second] < table.waiting[first])) {
+                std::swap(first, second);
+            }
+            if (table.hand_over(first)) woken[num_woken++] = first;
+            if (second != first && table.hand_over(second)) woken[num_woken++] = second;
+        }
+        for (int k = 0; k < num_woken; ++k) {
+            table.waiter_cvs[woken[k]].notify_one();
+        }
+    }
+}
+
+void DiningPhilosophers::philosopher_chandy_misra(int id, int iterations, bool verbose) {
+    using Message = ChandyMisraMessage;
+    
+    auto& mailboxes = forks_->mailboxes;
+    ChandyMisraPhilosopher self(id, num_philosophers_);
+    
+    int left_neighbor = (id + num_philosophers_ - 1) % num_philosophers_;
+    int right_neighbor = (id + 1) % num_philosophers_;
+    auto send = [&](int side, Message::Kind kind) {
+        int to = side == ChandyMisraPhilosopher::kLeft ? left_neighbor : right_neighbor;
+        mailboxes[to]->post(Message{kind, static_cast<uint8_t>(1 - side)});
+    };
+    
+    struct Host {
+        DiningPhilosophers& table;
+        int id;
+        bool verbose;
+        std::mt19937 gen{std::random_device{}()};
+        
+        std::chrono::nanoseconds think_time() { return table.think_time(gen); }
+        std::chrono::nanoseconds eat_time() { return table.eat_time(gen); }
+        void pass_time(std::chrono::nanoseconds duration) { table.pass_time(duration); }
+        
+        void hungry(int meal) {
+            if (verbose && meal < 10) {
+                std::cout << "Философ " << id << " размышляет (итерация " << meal + 1 << ")\n";
+            }
+            table.note_hungry(id);
+        }
+        void eating(int) { table.note_eating(id); }
+        void done(int meal) {
+            if (verbose && meal < 10) {
+                std::cout << "Философ " << id << " ест спагетти (итерация " << meal + 1 << ")\n";
+            }
+            table.note_done(id);
+        }
+    } host{*this, id, verbose};
+    
+    run_chandy_misra(self, *mailboxes[id], send, iterations, workload_.busy_wait, host);
+}
+
+void DiningPhilosophers::philosopher_atomic_bitmask(int id, int iterations, bool verbose) {
+    auto& words = forks_->fork_bits;
+    
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    
+    int left_fork = id;
+    int right_fork = (id + 1) % num_philosophers_;
+    std::atomic<uint64_t>& left_word = words[left_fork / 64];
+    std::atomic<uint64_t>& right_word = words[right_fork / 64];
+    uint64_t left_bit = 1ULL << (left_fork % 64);
+    uint64_t right_bit = 1ULL << (right_fork % 64);
+    bool same_word = &left_word == &right_word;
+    
+    for (int i = 0; i < iterations; ++i) {
+        // Размышление
+        pass_time(think_time(gen));
+        note_hungry(id);
+        
+        if (verbose && i < 10) {
+            std::cout << "Философ " << id << " размышляет (итерация " << i + 1 << ")\n";
+        }
+        
+        uint64_t observed;
+        if (same_word) {
+            // Обе вилки в одном слове - один CAS по маске из двух битов
+            while (!try_set_bits(left_word, left_bit | right_bit, observed)) {
+                left_word.wait(observed);
+            }
+        } else {
+            // Граница слов: левая вилка, затем правая; если правая занята,
+            // левая возвращается (никто не держит одну вилку в ожидании)
+            while (true) {
+                if (!try_set_bits(left_word, left_bit, observed)) {
+                    left_word.wait(observed);
+                    continue;
+                }
+                if (try_set_bits(right_word, right_bit, observed)) break;
+                clear_bits(left_word, left_bit);
+                right_word.wait(observed);
+            }
+        }
+        
+        note_eating(id);
+        
+        // Еда
+        pass_time(eat_time(gen));
+        
+        if (verbose && i < 10) {
+            std::cout << "Философ " << id << " ест спагетти (итерация " << i + 1 << ")\n";
+        }
+        note_done(id);
+        
+        // Возврат вилок
+        if (same_word) {
+            clear_bits(left_word, left_bit | right_bit);
+        } else {
+            clear_bits(left_word, left_bit);
+            clear_bits(right_word, right_bit);
+        }
+    }
+}
+
 void DiningPhilosophers::philosopher_resource_hierarchy(int id, int iterations, bool verbose) {
-    static std::vector<std::mutex> forks(num_philosophers_);
+    auto& forks = forks_->mutexes;
     
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> think_dist(50, 200);
-    std::uniform_int_distribution<> eat_dist(100, 300);
     
     // Присваиваем порядковые номера вилкам
     int first_fork, second_fork;
@@ -247,7 +643,8 @@ void DiningPhilosophers::philosopher_resource_hierarchy(int id, int iterations,
     
     for (int i = 0; i < iterations; ++i) {
         // Размышление
-        std::this_thread::sleep_for(std::chrono::milliseconds(think_dist(gen)));
+        pass_time(think_time(gen));
+        note_hungry(id);
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " размышляет (итерация " << i + 1 << ")\n";
@@ -255,14 +652,18 @@ void DiningPhilosophers::philosopher_resource_hierarchy(int id, int iterations,
         
         // Захват вилок в порядке возрастания номеров
         forks[first_fork].lock();
+        note_fork(first_fork);
         forks[second_fork].lock();
         
+        note_eating(id);
+        
         // Еда
-        std::this_thread::sleep_for(std::chrono::milliseconds(eat_dist(gen)));
+        pass_time(eat_time(gen));
         
         if (verbose && i < 10) {
             std::cout << "Философ " << id << " ест спагетти (итерация " << i + 1 << ")\n";
         }
+        note_done(id);
         
         // Освобождение вилок
         forks[second_fork].unlock();
@@ -270,18 +671,91 @@ void DiningPhilosophers::philosopher_resource_hierarchy(int id, int iterations,
     }
 }
 
-void DiningPhilosophers::run_simulation(int iterations, bool verbose) {
-    std::vector<std::thread> philosophers;
+std::string strategy_to_string(DiningPhilosophers::Strategy strategy) {
+    switch (strategy) {
+        case DiningPhilosophers::Strategy::MUTEX: return "Мьютексы";
+        case DiningPhilosophers::Strategy::SEMAPHORE: return "Семафоры";
+        case DiningPhilosophers::Strategy::TRY_LOCK: return "Попытка захвата";
+        case DiningPhilosophers::Strategy::ARBITRATOR: return "Арбитр";
+        case DiningPhilosophers::Strategy::RESOURCE_HIERARCHY: return "Иерархия ресурсов";
+        case DiningPhilosophers::Strategy::WAITER: return "Официант с очередью";
+        case DiningPhilosophers::Strategy::CHANDY_MISRA: return "Чанди-Мисра";
+        case DiningPhilosophers::Strategy::ATOMIC_BITMASK: return "Битовая маска CAS";
+    }
+    return "";
+}
+
+// Политики для меню и бенчмарка: прежняя равномерная пауза и
+// экспоненциальные от 1 мс, с фазой вращения и без
+static std::vector<BackoffPolicy> standard_backoff_policies() {
+    using Kind = BackoffPolicy::Kind;
+    using std::chrono::microseconds;
+    return {
+        {Kind::UNIFORM, microseconds(10000), microseconds(50000), 0},
+        {Kind::EXPONENTIAL, microseconds(1000), microseconds(50000), 0},
+        {Kind::DECORRELATED_JITTER, microseconds(1000), microseconds(50000), 0},
+        {Kind::EXPONENTIAL, microseconds(1000), microseconds(50000), 4},
+        {Kind::DECORRELATED_JITTER, microseconds(1000), microseconds(50000), 4}
+    };
+}
+
+const std::vector<DiningPhilosophers::Strategy>& all_strategies() {
+    using Strategy = DiningPhilosophers::Strategy;
+    static const std::vector<Strategy> strategies = {
+        Strategy::MUTEX,
+        Strategy::SEMAPHORE,
+        Strategy::TRY_LOCK,
+        Strategy::ARBITRATOR,
+        Strategy::RESOURCE_HIERARCHY,
+        Strategy::WAITER,
+        Strategy::CHANDY_MISRA,
+        Strategy::ATOMIC_BITMASK
+    };
+    return strategies;
+}
+
+static DiningPhilosophers::Strategy choose_strategy() {
+    const auto& strategies = all_strategies();
+    
+    std::cout << "\nВыберите стратегию синхронизации:\n";
+    for (size_t i = 0; i < strategies.size(); ++i) {
+        std::cout << i + 1 << ". " << strategy_to_string(strategies[i]) << "\n";
+    }
+    std::cout << "Ваш выбор: ";
+    
+    int choice;
+    std::cin >> choice;
+    if (choice < 1 || choice > static_cast<int>(strategies.size())) choice = 1;
+    return strategies[choice - 1];
+}
+
+static BackoffPolicy choose_backoff_policy() {
+    std::vector<BackoffPolicy> policies = standard_backoff_policies();
+    
+    std::cout << "\nПолитика отсрочки после неудачного try_lock:\n";
+    for (size_t i = 0; i < policies.size(); ++i) {
+        std::cout << i + 1 << ". " << backoff_to_string(policies[i]) << "\n";
+    }
+    std::cout << "Ваш выбор: ";
     
-    std::string strategy_name;
-    switch (strategy_) {
-        case Strategy::MUTEX: strategy_name = "Мьютексы"; break;
-        case Strategy::SEMAPHORE: strategy_name = "Семафоры"; break;
-        case Strategy::TRY_LOCK: strategy_name = "Попытка захвата"; break;
-        case Strategy::ARBITRATOR: strategy_name = "Арбитр"; break;
-        case Strategy::RESOURCE_HIERARCHY: strategy_name = "Иерархия ресурсов"; break;
+    int choice;
+    std::cin >> choice;
+    if (choice < 1 || choice > static_cast<int>(policies.size())) choice = 1;
+    return policies[choice - 1];
+}
+
+void DiningPhilosophers::run_simulation(int iterations, bool verbose) {
+    if (mode_ == ExecutionMode::VIRTUAL_TIME) {
+        run_virtual_simulation(iterations, verbose);
+        return;
+    }
+    if (mode_ == ExecutionMode::COROUTINES) {
+        run_coroutine_simulation(iterations, verbose);
+        return;
     }
     
+    std::string strategy_name = strategy_to_string(strategy_);
+    
     std::cout << "\n=== Задача обедающих философов ===\n";
     std::cout << "Философов: " << num_philosophers_ << "\n";
     std::cout << "Стратегия: " << strategy_name << "\n";
@@ -291,6 +765,28 @@ void DiningPhilosophers::run_simulation(int iterations, bool verbose) {
         std::cout << "(Вывод ограничен первыми 10 итерациями)\n";
     }
     
+    run_threads(iterations, verbose);
+    
+    std::cout << "\nСимуляция завершена успешно!\n";
+}
+
+void DiningPhilosophers::run_meals(int iterations) {
+    run_threads(iterations, false);
+}
+
+TableMetrics DiningPhilosophers::run_with_metrics(int iterations) {
+    metrics_ = std::make_unique<PhilosopherMetrics>(num_philosophers_, iterations);
+    run_threads(iterations, false);
+    TableMetrics result = metrics_->report();
+    metrics_.reset();
+    return result;
+}
+
+void DiningPhilosophers::run_threads(int iterations, bool verbose) {
+    // Новый набор вилок на каждый прогон
+    forks_ = std::make_unique<ForkTable>(num_philosophers_);
+    std::vector<std::thread> philosophers;
+    
     // Запуск философов
     for (int i = 0; i < num_philosophers_; ++i) {
         switch (strategy_) {
@@ -314,6 +810,18 @@ void DiningPhilosophers::run_simulation(int iterations, bool verbose) {
                 philosophers.emplace_back(&DiningPhilosophers::philosopher_resource_hierarchy, 
                                          this, i, iterations, verbose);
                 break;
+            case Strategy::WAITER:
+                philosophers.emplace_back(&DiningPhilosophers::philosopher_waiter, 
+                                         this, i, iterations, verbose);
+                break;
+            case Strategy::CHANDY_MISRA:
+                philosophers.emplace_back(&DiningPhilosophers::philosopher_chandy_misra, 
+                                         this, i, iterations, verbose);
+                break;
+            case Strategy::ATOMIC_BITMASK:
+                philosophers.emplace_back(&DiningPhilosophers::philosopher_atomic_bitmask, 
+                                         this, i, iterations, verbose);
+                break;
         }
     }
     
@@ -321,37 +829,188 @@ void DiningPhilosophers::run_simulation(int iterations, bool verbose) {
     for (auto& p : philosophers) {
         p.join();
     }
+}
+
+void DiningPhilosophers::run_virtual_simulation(int iterations, bool verbose) {
+    std::cout << "\n=== Задача обедающих философов (виртуальное время) ===\n";
+    std::cout << "Философов: " << num_philosophers_ << "\n";
+    std::cout << "Стратегия: " << strategy_to_string(strategy_) << "\n";
+    std::cout << "Итераций: " << iterations << "\n";
+    
+    if (verbose && iterations > 10) {
+        std::cout << "(Вывод ограничен первыми 10 итерациями)\n";
+    }
+    
+    VirtualTimeStats stats = simulate_virtual_time(num_philosophers_, strategy_, iterations, backoff_, verbose);
+    
+    auto [min_meals, max_meals] = std::minmax_element(stats.meals_per_philosopher.begin(),
+                                                      stats.meals_per_philosopher.end());
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nТрапез: " << stats.meals << " (событий: " << stats.events << ")\n";
+    std::cout << "Виртуальное время: " << stats.simulated_seconds << " с, "
+              << stats.meals_per_simulated_second() << " трапез/с\n";
+    std::cout << "Ожидание вилок: среднее " << stats.average_wait_ms << " мс, максимальное "
+              << stats.max_wait_ms << " мс\n";
+    std::cout << "Трапез на философа: от " << *min_meals << " до " << *max_meals << "\n";
+    std::cout << "Пробуждений ждущих: " << stats.wakeups << " (" << stats.wakeups_per_meal()
+              << " на трапезу)\n";
+    std::cout << "Реальное время движка: " << stats.wall_seconds * 1000.0 << " мс ("
+              << stats.meals_per_wall_second() / 1e6 << " млн трапез/с)\n";
+    
+    if (stats.deadlock) {
+        std::cout << "\nВзаимная блокировка: события закончились, все философы ждут вилок\n";
+    } else {
+        std::cout << "\nСимуляция завершена успешно!\n";
+    }
+}
+
+void DiningPhilosophers::run_virtual_benchmark(int max_philosophers, int iterations) {
+    std::cout << "\n=== Бенчмарк философов в виртуальном времени ===\n";
+    std::cout << "Итераций на философа: " << iterations << "\n\n";
+    
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    
+    const std::vector<Strategy>& strategies = all_strategies();
+    
+    std::vector<int> philosopher_counts = {5, 10, 20};
+    
+    std::cout << std::setw(10) << "Философов"
+              << std::setw(22) << "Стратегия"
+              << std::setw(16) << "Трапез/с (вирт)"
+              << std::setw(18) << "Ожидание (мс)"
+              << std::setw(16) << "Макс. (мс)"
+              << std::setw(18) << "Пробужд./трапезу"
+              << std::setw(18) << "Млн трапез/с" << "\n";
+    std::cout << std::string(118, '-') << std::endl;
+    
+    for (int count : philosopher_counts) {
+        if (count > max_philosophers) continue;
+        
+        for (Strategy strategy : strategies) {
+            VirtualTimeStats stats = simulate_virtual_time(count, strategy, iterations);
+            std::string name = strategy_to_string(strategy);
+            
+            std::cout << std::setw(10) << count
+                      << std::setw(22) << name
+                      << std::setw(16) << std::fixed << std::setprecision(2) << stats.meals_per_simulated_second()
+                      << std::setw(18) << stats.average_wait_ms
+                      << std::setw(16) << stats.max_wait_ms
+                      << std::setw(18) << stats.wakeups_per_meal()
+                      << std::setw(18) << stats.meals_per_wall_second() / 1e6
+                      << (stats.deadlock ? "  взаимная блокировка" : "") << "\n";
+            
+            std::string test_name = std::to_string(count) + "_философов_" + name;
+            benchmark_results.emplace_back(test_name + "_трапез_в_с", stats.meals_per_simulated_second());
+            benchmark_results.emplace_back(test_name + "_ожидание_мс", stats.average_wait_ms);
+            benchmark_results.emplace_back(test_name + "_пробуждений_на_трапезу", stats.wakeups_per_meal());
+        }
+    }
+    
+    Benchmark::save_to_csv(benchmark_results, "philosophers_virtual_benchmark.csv");
+}
+
+void DiningPhilosophers::run_coroutine_simulation(int iterations, bool verbose) {
+    std::cout << "\n=== Задача обедающих философов (сопрограммы) ===\n";
+    std::cout << "Философов: " << num_philosophers_ << "\n";
+    std::cout << "Стратегия: " << strategy_to_string(strategy_) << "\n";
+    std::cout << "Итераций: " << iterations << "\n";
+    
+    if (verbose && iterations > 10) {
+        std::cout << "(Вывод ограничен первыми 10 итерациями)\n";
+    }
     
+    CoroutineStats stats = simulate_coroutines(num_philosophers_, strategy_, iterations, backoff_, 0, verbose);
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nТрапез: " << stats.meals << " за " << stats.wall_seconds << " с ("
+              << stats.meals_per_second() << " трапез/с)\n";
+    std::cout << "Потоков пула: " << stats.workers << ", срабатываний таймеров: " << stats.timers << "\n";
+    std::cout << "Ожидание вилок: среднее " << stats.average_wait_ms << " мс, максимальное "
+              << stats.max_wait_ms << " мс\n";
     std::cout << "\nСимуляция завершена успешно!\n";
 }
 
+void DiningPhilosophers::run_coroutine_benchmark(int max_philosophers, int iterations) {
+    std::cout << "\n=== Бенчмарк философов-сопрограмм ===\n";
+    std::cout << "Итераций на философа: " << iterations << "\n\n";
+    
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    
+    const std::vector<Strategy>& strategies = all_strategies();
+    
+    std::vector<int> philosopher_counts = {10000, 50000, 100000};
+    
+    std::cout << std::setw(10) << "Философов"
+              << std::setw(22) << "Стратегия"
+              << std::setw(12) << "Время (с)"
+              << std::setw(14) << "Трапез/с"
+              << std::setw(18) << "Ожидание (мс)"
+              << std::setw(14) << "Макс. (мс)" << "\n";
+    std::cout << std::string(90, '-') << std::endl;
+    
+    for (int count : philosopher_counts) {
+        if (count > max_philosophers) continue;
+        
+        for (Strategy strategy : strategies) {
+            CoroutineStats stats = simulate_coroutines(count, strategy, iterations);
+            std::string name = strategy_to_string(strategy);
+            
+            std::cout << std::setw(10) << count
+                      << std::setw(22) << name
+                      << std::setw(12) << std::fixed << std::setprecision(2) << stats.wall_seconds
+                      << std::setw(14) << std::setprecision(0) << stats.meals_per_second()
+                      << std::setw(18) << std::setprecision(2) << stats.average_wait_ms
+                      << std::setw(14) << stats.max_wait_ms << "\n";
+            
+            std::string test_name = std::to_string(count) + "_философов_" + name;
+            benchmark_results.emplace_back(test_name + "_трапез_в_с", stats.meals_per_second());
+            benchmark_results.emplace_back(test_name + "_ожидание_мс", stats.average_wait_ms);
+        }
+    }
+    
+    Benchmark::save_to_csv(benchmark_results, "philosophers_coroutines_benchmark.csv");
+}
+
 void DiningPhilosophers::run_benchmark(int max_philosophers, int iterations) {
+    if (mode_ == ExecutionMode::VIRTUAL_TIME) {
+        run_virtual_benchmark(max_philosophers, iterations);
+        return;
+    }
+    if (mode_ == ExecutionMode::COROUTINES) {
+        run_coroutine_benchmark(max_philosophers, iterations);
+        return;
+    }
+    
     std::cout << "\n=== Бенчмарк задачи обедающих философов ===\n";
     std::cout << "Тестируем разные стратегии и количество философов\n\n";
     
     std::vector<std::pair<std::string, double>> benchmark_results;
     
-    std::vector<Strategy> strategies = {
-        Strategy::MUTEX,
-        Strategy::SEMAPHORE,
-        Strategy::TRY_LOCK,
-        Strategy::ARBITRATOR,
-        Strategy::RESOURCE_HIERARCHY
-    };
+    const std::vector<Strategy>& strategies = all_strategies();
     
     std::vector<std::string> strategy_names = {
         "Мьютексы",
         "Семафоры",
         "Попытка захвата",
         "Арбитр",
-        "Иерархия ресурсов"
+        "Иерархия ресурсов",
+        "Официант с очередью",
+        "Чанди-Мисра",
+        "Битовая маска CAS"
     };
     
     std::vector<int> philosopher_counts = {5, 10, 20};
     
+    // Подробные метрики каждого прогона (стратегия -> стол)
+    std::vector<std::pair<std::string, TableMetrics>> metrics_runs;
+    
+    // Время арбитра с опросом и официанта с очередью для итогового сравнения
+    std::vector<std::pair<int, std::pair<double, double>>> arbitrator_vs_waiter;
+    
     for (int count : philosopher_counts) {
         if (count > max_philosophers) continue;
         
+        double arbitrator_time = 0.0, waiter_time = 0.0;
         for (size_t s = 0; s < strategies.size(); ++s) {
             std::string test_name = std::to_string(count) + "_философов_" + strategy_names[s];
             
@@ -360,16 +1019,41 @@ void DiningPhilosophers::run_benchmark(int max_philosophers, int iterations) {
             DiningPhilosophers dp(count, strategies[s]);
             
             Benchmark b(test_name, false);
-            dp.run_simulation(iterations, false);
+            TableMetrics metrics = dp.run_with_metrics(iterations);
             
             double time = b.elapsed_microseconds();
             benchmark_results.emplace_back(test_name, time);
+            metrics_runs.emplace_back(strategy_names[s], metrics);
+            if (strategies[s] == Strategy::ARBITRATOR) arbitrator_time = time;
+            if (strategies[s] == Strategy::WAITER) waiter_time = time;
             
             std::cout << time << " мкс\n";
+            std::cout << std::fixed << std::setprecision(1)
+                      << "    ожидание: среднее " << metrics.average_wait_ms()
+                      << " мс, p99 " << metrics.wait_percentile_ms(0.99)
+                      << " мс, макс. голодание " << metrics.max_wait_ms() << " мс\n"
+                      << std::setprecision(2)
+                      << "    едящих в среднем " << metrics.average_eaters
+                      << " из " << metrics.max_concurrency()
+                      << " (макс. " << metrics.max_eaters << "), справедливость " << metrics.fairness
+                      << ", занятость вилок " << metrics.average_fork_utilization() * 100.0 << "%\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+        arbitrator_vs_waiter.push_back({count, {arbitrator_time, waiter_time}});
+    }
+    
+    std::cout << "\nАрбитр с опросом раз в 10 мс против официанта с очередью:\n";
+    for (const auto& [count, times] : arbitrator_vs_waiter) {
+        std::cout << "  " << count << " философов: " << std::fixed << std::setprecision(1)
+                  << times.first / 1000.0 << " мс против " << times.second / 1000.0 << " мс";
+        if (times.second > 0.0) {
+            std::cout << " (ускорение " << std::setprecision(2) << times.first / times.second << "x)";
         }
+        std::cout << "\n";
     }
     
     Benchmark::save_to_csv(benchmark_results, "philosophers_benchmark.csv");
+    save_metrics_csv(metrics_runs, "philosophers_metrics.csv", "philosophers_wait_histograms.csv");
     std::cout << "\nБенчмарк завершен. Результаты сохранены в philosophers_benchmark.csv\n";
 }
 
@@ -381,12 +1065,20 @@ void run_philosophers() {
     std::cout << "Выберите режим:\n";
     std::cout << "1. Стандартная симуляция\n";
     std::cout << "2. Расширенный бенчмарк\n";
+    std::cout << "3. Симуляция в виртуальном времени\n";
+    std::cout << "4. Бенчмарк в виртуальном времени\n";
+    std::cout << "5. Параллельные столы на пуле потоков\n";
+    std::cout << "6. Симуляция на сопрограммах (до 100 000 философов)\n";
+    std::cout << "7. Бенчмарк сопрограмм (10 000 - 100 000 философов)\n";
+    std::cout << "8. Конкуренция за вилки без сна (0 нс - 10 мкс)\n";
+    std::cout << "9. Общий граф задач и ресурсов (пьющие философы)\n";
+    std::cout << "10. Политики отсрочки для попытки захвата\n";
     std::cout << "Ваш выбор: ";
     std::cin >> choice;
     
     switch (choice) {
         case 1: {
-            int num_philosophers, iterations, strategy_choice;
+            int num_philosophers, iterations;
             
             std::cout << "\nВведите количество философов (2-20): ";
             std::cin >> num_philosophers;
@@ -394,31 +1086,17 @@ void run_philosophers() {
             std::cout << "Введите количество итераций на философа (1-100): ";
             std::cin >> iterations;
             
-            std::cout << "\nВыберите стратегию синхронизации:\n";
-            std::cout << "1. Мьютексы (стандартная)\n";
-            std::cout << "2. Семафоры\n";
-            std::cout << "3. Попытка захвата (try_lock)\n";
-            std::cout << "4. Арбитр (официант)\n";
-            std::cout << "5. Иерархия ресурсов\n";
-            std::cout << "Ваш выбор: ";
-            std::cin >> strategy_choice;
+            DiningPhilosophers::Strategy strategy = choose_strategy();
             
             if (num_philosophers < 2) num_philosophers = 2;
             if (num_philosophers > 20) num_philosophers = 20;
             if (iterations < 1) iterations = 1;
             if (iterations > 100) iterations = 100;
             
-            DiningPhilosophers::Strategy strategy;
-            switch (strategy_choice) {
-                case 1: strategy = DiningPhilosophers::Strategy::MUTEX; break;
-                case 2: strategy = DiningPhilosophers::Strategy::SEMAPHORE; break;
-                case 3: strategy = DiningPhilosophers::Strategy::TRY_LOCK; break;
-                case 4: strategy = DiningPhilosophers::Strategy::ARBITRATOR; break;
-                case 5: strategy = DiningPhilosophers::Strategy::RESOURCE_HIERARCHY; break;
-                default: strategy = DiningPhilosophers::Strategy::MUTEX;
-            }
-            
             DiningPhilosophers dp(num_philosophers, strategy);
+            if (strategy == DiningPhilosophers::Strategy::TRY_LOCK) {
+                dp.set_backoff(choose_backoff_policy());
+            }
             
             Benchmark b("Симуляция обедающих философов");
             dp.run_simulation(iterations, true);
@@ -435,6 +1113,70 @@ void run_philosophers() {
             run_philosophers_benchmark();
             break;
         }
+        case 3: {
+            int num_philosophers, iterations;
+            
+            std::cout << "\nВведите количество философов (2-1000): ";
+            std::cin >> num_philosophers;
+            
+            std::cout << "Введите количество итераций на философа (1-1000000): ";
+            std::cin >> iterations;
+            
+            DiningPhilosophers::Strategy strategy = choose_strategy();
+            
+            if (num_philosophers < 2) num_philosophers = 2;
+            if (num_philosophers > 1000) num_philosophers = 1000;
+            if (iterations < 1) iterations = 1;
+            if (iterations > 1000000) iterations = 1000000;
+            
+            DiningPhilosophers dp(num_philosophers, strategy, DiningPhilosophers::ExecutionMode::VIRTUAL_TIME);
+            if (strategy == DiningPhilosophers::Strategy::TRY_LOCK) {
+                dp.set_backoff(choose_backoff_policy());
+            }
+            dp.run_simulation(iterations, num_philosophers <= 20);
+            break;
+        }
+        case 4:
+            run_virtual_time_benchmark();
+            break;
+        case 5:
+            run_concurrent_tables_benchmark();
+            break;
+        case 6: {
+            int num_philosophers, iterations;
+            
+            std::cout << "\nВведите количество философов (2-100000): ";
+            std::cin >> num_philosophers;
+            
+            std::cout << "Введите количество итераций на философа (1-100): ";
+            std::cin >> iterations;
+            
+            DiningPhilosophers::Strategy strategy = choose_strategy();
+            
+            if (num_philosophers < 2) num_philosophers = 2;
+            if (num_philosophers > 100000) num_philosophers = 100000;
+            if (iterations < 1) iterations = 1;
+            if (iterations > 100) iterations = 100;
+            
+            DiningPhilosophers dp(num_philosophers, strategy, DiningPhilosophers::ExecutionMode::COROUTINES);
+            if (strategy == DiningPhilosophers::Strategy::TRY_LOCK) {
+                dp.set_backoff(choose_backoff_policy());
+            }
+            dp.run_simulation(iterations, num_philosophers <= 20);
+            break;
+        }
+        case 7:
+            run_coroutine_philosophers_benchmark();
+            break;
+        case 8:
+            run_contention_benchmark();
+            break;
+        case 9:
+            run_drinking_philosophers();
+            break;
+        case 10:
+            run_backoff_benchmark();
+            break;
         default:
             std::cout << "Неверный выбор! Запускаю стандартную симуляцию...\n";
             DiningPhilosophers dp(5, DiningPhilosophers::Strategy::MUTEX);
@@ -458,4 +1200,229 @@ void run_philosophers_benchmark() {
     dp.run_benchmark(20, iterations);
 }
 
+void run_virtual_time_benchmark() {
+    int iterations;
+    std::cout << "\nВведите количество итераций на философа (100-1000000): ";
+    std::cin >> iterations;
+    
+    if (iterations < 100) iterations = 100;
+    if (iterations > 1000000) iterations = 1000000;
+    
+    DiningPhilosophers dp(5, DiningPhilosophers::Strategy::MUTEX, DiningPhilosophers::ExecutionMode::VIRTUAL_TIME);
+    dp.run_benchmark(20, iterations);
+}
+
+void run_coroutine_philosophers_benchmark() {
+    int iterations;
+    std::cout << "\nВведите количество итераций на философа (1-20): ";
+    std::cin >> iterations;
+    
+    if (iterations < 1) iterations = 1;
+    if (iterations > 20) iterations = 20;
+    
+    DiningPhilosophers dp(5, DiningPhilosophers::Strategy::MUTEX, DiningPhilosophers::ExecutionMode::COROUTINES);
+    dp.run_benchmark(100000, iterations);
+}
+
+void run_contention_benchmark() {
+    std::cout << "\n=== Конкуренция за вилки: занятое ожидание вместо сна ===\n";
+    
+    int iterations;
+    std::cout << "Введите количество трапез на философа (100-100000): ";
+    std::cin >> iterations;
+    
+    if (iterations < 100) iterations = 100;
+    if (iterations > 100000) iterations = 100000;
+    
+    // Семафоры берут левую вилку, потом правую без порядка: без пауз
+    // взаимная блокировка почти неизбежна, прогон бы повис
+    std::vector<DiningPhilosophers::Strategy> strategies;
+    for (auto strategy : all_strategies()) {
+        if (strategy != DiningPhilosophers::Strategy::SEMAPHORE) strategies.push_back(strategy);
+    }
+    
+    std::vector<int> workloads_ns = {0, 100, 1000, 10000};
+    std::vector<int> philosopher_counts = {5, 20};
+    
+    std::cout << "(Семафоры пропущены: без пауз они блокируются взаимно)\n\n";
+    std::cout << std::setw(12) << "Нагрузка"
+              << std::setw(10) << "Философов"
+              << std::setw(22) << "Стратегия"
+              << std::setw(12) << "Время (с)"
+              << std::setw(16) << "Трапез/с" << "\n";
+    std::cout << std::string(72, '-') << std::endl;
+    
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    
+    for (int work_ns : workloads_ns) {
+        std::string work_name = work_ns >= 1000 ? std::to_string(work_ns / 1000) + " мкс"
+                                                : std::to_string(work_ns) + " нс";
+        for (int count : philosopher_counts) {
+            for (auto strategy : strategies) {
+                DiningPhilosophers dp(count, strategy);
+                dp.set_workload(DiningPhilosophers::Workload::spinning(work_ns));
+                
+                Benchmark b("Конкуренция за вилки", false);
+                dp.run_meals(iterations);
+                double seconds = b.elapsed_seconds();
+                double meals_per_second = seconds > 0.0 ? count * iterations / seconds : 0.0;
+                std::string name = strategy_to_string(strategy);
+                
+                std::cout << std::setw(12) << work_name
+                          << std::setw(10) << count
+                          << std::setw(22) << name
+                          << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+                          << std::setw(16) << std::setprecision(0) << meals_per_second << "\n";
+                
+                benchmark_results.emplace_back(std::to_string(work_ns) + "нс_" + std::to_string(count) +
+                                               "_философов_" + name, meals_per_second);
+            }
+        }
+    }
+    
+    Benchmark::save_to_csv(benchmark_results, "philosophers_contention_benchmark.csv");
+}
+
+void run_backoff_benchmark() {
+    std::cout << "\n=== Политики отсрочки стратегии try_lock ===\n";
+    
+    int iterations;
+    std::cout << "Введите количество итераций на философа (5-50): ";
+    std::cin >> iterations;
+    
+    if (iterations < 5) iterations = 5;
+    if (iterations > 50) iterations = 50;
+    
+    std::vector<BackoffPolicy> policies = standard_backoff_policies();
+    std::vector<int> philosopher_counts = {5, 10, 20};
+    
+    std::cout << "\n" << std::setw(10) << "Философов"
+              << std::setw(36) << "Политика"
+              << std::setw(12) << "Время (с)"
+              << std::setw(12) << "Трапез/с"
+              << std::setw(12) << "Повторов"
+              << std::setw(16) << "Повт./трапезу"
+              << std::setw(16) << "p99 ожид. (мс)" << "\n";
+    std::cout << std::string(114, '-') << std::endl;
+    
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    
+    for (int count : philosopher_counts) {
+        for (const BackoffPolicy& policy : policies) {
+            DiningPhilosophers dp(count, DiningPhilosophers::Strategy::TRY_LOCK);
+            dp.set_backoff(policy);
+            TableMetrics metrics = dp.run_with_metrics(iterations);
+            
+            long long meals = static_cast<long long>(count) * iterations;
+            double meals_per_second = metrics.wall_seconds > 0.0 ? meals / metrics.wall_seconds : 0.0;
+            double retries_per_meal = static_cast<double>(metrics.total_retries()) / meals;
+            std::string name = backoff_to_string(policy);
+            
+            std::cout << std::setw(10) << count
+                      << std::setw(36) << name
+                      << std::setw(12) << std::fixed << std::setprecision(2) << metrics.wall_seconds
+                      << std::setw(12) << meals_per_second
+                      << std::setw(12) << metrics.total_retries()
+                      << std::setw(16) << retries_per_meal
+                      << std::setw(16) << std::setprecision(1) << metrics.wait_percentile_ms(0.99) << "\n";
+            
+            std::string test_name = std::to_string(count) + "_философов_" + name;
+            benchmark_results.emplace_back(test_name + "_трапез_в_с", meals_per_second);
+            benchmark_results.emplace_back(test_name + "_повторов_на_трапезу", retries_per_meal);
+        }
+    }
+    std::cout.unsetf(std::ios::fixed);
+    
+    Benchmark::save_to_csv(benchmark_results, "philosophers_backoff_benchmark.csv");
+}
+
+ConcurrentTablesResult run_concurrent_tables(int num_tables, int philosophers_per_table,
+                                             DiningPhilosophers::Strategy strategy,
+                                             int iterations, int concurrency,
+                                             const DiningPhilosophers::Workload& workload) {
+    ConcurrentTablesResult result;
+    if (num_tables < 1) return result;
+    
+    // Вызывающий поток только ждет, столы выполняют фоновые потоки общего
+    // пула: одновременно идет не больше concurrency столов, остальные ждут
+    // в очередях
+    ThreadPool& pool = ThreadPool::shared(std::max(1, concurrency) + 1);
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    int remaining = num_tables;
+    
+    Benchmark b("Параллельные столы", false);
+    for (int t = 0; t < num_tables; ++t) {
+        pool.submit([&]() {
+            DiningPhilosophers table(philosophers_per_table, strategy);
+            table.set_workload(workload);
+            table.run_meals(iterations);
+            
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (--remaining == 0) done_cv.notify_one();
+        });
+    }
+    
+    {
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done_cv.wait(lock, [&]() { return remaining == 0; });
+    }
+    
+    result.wall_seconds = b.elapsed_seconds();
+    result.meals = static_cast<long long>(num_tables) * philosophers_per_table * iterations;
+    return result;
+}
+
+void run_concurrent_tables_benchmark() {
+    std::cout << "\n=== Параллельные столы обедающих философов ===\n";
+    
+    const int philosophers_per_table = 5;
+    const int iterations = 100;
+    const int work_ns = 10000;
+    
+    std::vector<DiningPhilosophers::Strategy> strategies = {
+        DiningPhilosophers::Strategy::MUTEX,
+        DiningPhilosophers::Strategy::RESOURCE_HIERARCHY,
+        DiningPhilosophers::Strategy::ARBITRATOR
+    };
+    
+    // Философы вращаются вместо сна: стол занимает процессор, поэтому
+    // одновременно идет столько столов, сколько ядер. Спящие столы пул
+    // выполнял бы по одному, не загружая ядра
+    int concurrency = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> table_counts = {1, concurrency, 10, 50, 100, 200, 500};
+    std::sort(table_counts.begin(), table_counts.end());
+    table_counts.erase(std::unique(table_counts.begin(), table_counts.end()), table_counts.end());
+    
+    std::cout << "Философов за столом: " << philosophers_per_table
+              << ", итераций: " << iterations
+              << ", размышление и еда: " << work_ns / 1000 << " мкс вращения"
+              << ", одновременных столов: " << concurrency << "\n\n";
+    std::cout << std::setw(8) << "Столов"
+              << std::setw(22) << "Стратегия"
+              << std::setw(14) << "Время (с)"
+              << std::setw(16) << "Трапез/с" << "\n";
+    std::cout << std::string(60, '-') << std::endl;
+    
+    std::vector<std::pair<std::string, double>> benchmark_results;
+    
+    for (auto strategy : strategies) {
+        for (int tables : table_counts) {
+            ConcurrentTablesResult r = run_concurrent_tables(tables, philosophers_per_table,
+                                                             strategy, iterations, concurrency,
+                                                             DiningPhilosophers::Workload::spinning(work_ns));
+            std::string name = strategy_to_string(strategy);
+            
+            std::cout << std::setw(8) << tables
+                      << std::setw(22) << name
+                      << std::setw(14) << std::fixed << std::setprecision(3) << r.wall_seconds
+                      << std::setw(16) << std::setprecision(1) << r.meals_per_second() << "\n";
+            
+            benchmark_results.emplace_back(std::to_string(tables) + "_столов_" + name, r.meals_per_second());
+        }
+    }
+    
+    Benchmark::save_to_csv(benchmark_results, "philosophers_tables_benchmark.csv");
+}
+
 } // namespace task3
@@ -1,11 +1,59 @@
 #ifndef TASK3_PHILOSOPHERS_H
 #define TASK3_PHILOSOPHERS_H
 
+#include "task3_metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
 namespace task3 {
 
+// Пауза после неудачного try_lock.
+//   UNIFORM             - равномерно в [base, cap], без учета истории
+//   EXPONENTIAL         - равномерно в [0, min(cap, base * 2^k)] после
+//                         k-й неудачи (экспонента с полным разбросом)
+//   DECORRELATED_JITTER - равномерно в [base, 3 * предыдущая], не больше cap
+// Первые spin_attempts неудач вместо сна - вращение 1, 2, 4... мкс:
+// короткий захват соседа дешевле переждать, не отдавая процессор.
+struct BackoffPolicy {
+    enum class Kind { UNIFORM, EXPONENTIAL, DECORRELATED_JITTER };
+    
+    Kind kind = Kind::UNIFORM;
+    std::chrono::microseconds base{10000};
+    std::chrono::microseconds cap{50000};
+    int spin_attempts = 0;
+};
+
+std::string backoff_to_string(const BackoffPolicy& policy);
+
+// Состояние отсрочки одного захвата: новое на каждое "проголодался"
+class Backoff {
+public:
+    struct Delay {
+        std::chrono::nanoseconds duration;
+        bool spin;                          // вращение вместо сна
+    };
+    
+    explicit Backoff(const BackoffPolicy& policy) : policy_(policy) {}
+    
+    Delay next(std::mt19937& gen);
+    // Сопрограммы хранят в кадре minstd_rand вместо 5 КБ mt19937
+    Delay next(std::minstd_rand& gen);
+    int failures() const { return failures_; }
+    
+private:
+    template <typename Generator>
+    Delay next_delay(Generator& gen);
+    
+    const BackoffPolicy& policy_;
+    int failures_ = 0;
+    long long previous_us_ = 0;
+};
+
 class DiningPhilosophers {
 public:
     enum class Strategy {
@@ -13,26 +61,136 @@ public:
         SEMAPHORE,          // Использование семафоров
         TRY_LOCK,           // Попытка захвата вилок
         ARBITRATOR,         // Арбитр (официант)
-        RESOURCE_HIERARCHY  // Иерархия ресурсов
+        RESOURCE_HIERARCHY, // Иерархия ресурсов
+        WAITER,             // Официант с очередью ожидающих
+        CHANDY_MISRA,       // Чанди-Мисра: обмен сообщениями о вилках
+        ATOMIC_BITMASK      // Вилки - биты атомарных слов, обе берутся одним CAS
     };
     
-    DiningPhilosophers(int num_philosophers = 5, Strategy strategy = Strategy::MUTEX);
+    enum class ExecutionMode {
+        REAL_TIME,          // Потоки и sleep_for
+        VIRTUAL_TIME,       // Дискретно-событийная симуляция
+        COROUTINES          // Сопрограммы на пуле потоков и колесе таймеров
+    };
+    
+    // Размышление и еда потоков-философов. По умолчанию sleep_for на
+    // 50-200 и 100-300 мс; при busy_wait - калиброванный цикл вычислений
+    // заданной длины (0 - без пауз), а паузы повторных попыток
+    // заменяются уступкой процессора: видна только цена синхронизации.
+    struct Workload {
+        bool busy_wait = false;
+        int think_ns = 0;
+        int eat_ns = 0;
+        
+        static Workload sleeping() { return {}; }
+        static Workload spinning(int ns) { return {true, ns, ns}; }
+    };
+    
+    DiningPhilosophers(int num_philosophers = 5, Strategy strategy = Strategy::MUTEX,
+                       ExecutionMode mode = ExecutionMode::REAL_TIME);
+    ~DiningPhilosophers();
+    
+    DiningPhilosophers(const DiningPhilosophers&) = delete;
+    DiningPhilosophers& operator=(const DiningPhilosophers&) = delete;
+    
     void run_simulation(int iterations, bool verbose = true);
     void run_benchmark(int max_philosophers, int iterations);
     
+    // Только потоки философов, без вывода (для параллельных столов)
+    void run_meals(int iterations);
+    
+    // Прогон потоков с замером ожидания, голодания, справедливости и
+    // занятости вилок
+    TableMetrics run_with_metrics(int iterations);
+    
+    // Только для ExecutionMode::REAL_TIME
+    void set_workload(const Workload& workload);
+    // Отсрочка стратегии TRY_LOCK во всех режимах исполнения; при busy_wait
+    // сон заменяется уступкой процессора, фаза вращения остается
+    void set_backoff(const BackoffPolicy& policy) { backoff_ = policy; }
+    
 private:
+    // Вилки и состояние арбитра этого стола
+    struct ForkTable;
+    
     int num_philosophers_;
     Strategy strategy_;
+    ExecutionMode mode_;
+    Workload workload_;
+    BackoffPolicy backoff_;
+    std::unique_ptr<ForkTable> forks_;
+    std::unique_ptr<PhilosopherMetrics> metrics_;
+    
+    void run_threads(int iterations, bool verbose);
+    
+    std::chrono::nanoseconds think_time(std::mt19937& gen) const;
+    std::chrono::nanoseconds eat_time(std::mt19937& gen) const;
+    void pass_time(std::chrono::nanoseconds duration) const;
+    void retry_pause(std::chrono::nanoseconds duration) const;
+    
+    void note_hungry(int id);
+    void note_fork(int fork);
+    void note_eating(int id);
+    void note_done(int id);
+    void note_retry(int id);
+    void run_virtual_simulation(int iterations, bool verbose);
+    void run_virtual_benchmark(int max_philosophers, int iterations);
+    void run_coroutine_simulation(int iterations, bool verbose);
+    void run_coroutine_benchmark(int max_philosophers, int iterations);
     
     void philosopher_mutex(int id, int iterations, bool verbose);
     void philosopher_semaphore(int id, int iterations, bool verbose);
     void philosopher_try_lock(int id, int iterations, bool verbose);
     void philosopher_arbitrator(int id, int iterations, bool verbose);
     void philosopher_resource_hierarchy(int id, int iterations, bool verbose);
+    void philosopher_waiter(int id, int iterations, bool verbose);
+    void philosopher_chandy_misra(int id, int iterations, bool verbose);
+    void philosopher_atomic_bitmask(int id, int iterations, bool verbose);
 };
 
+std::string strategy_to_string(DiningPhilosophers::Strategy strategy);
+// Все стратегии в порядке меню и таблиц бенчмарков
+const std::vector<DiningPhilosophers::Strategy>& all_strategies();
+
+// Калиброванная занятость процессора без обращения к часам
+void busy_work(std::chrono::nanoseconds duration);
+
+// Один CAS: занять все биты mask, если они свободны. false - часть битов
+// занята, observed - значение слова, на котором нужно ждать
+bool try_set_bits(std::atomic<uint64_t>& word, uint64_t mask, uint64_t& observed);
+void clear_bits(std::atomic<uint64_t>& word, uint64_t mask);
+
 void run_philosophers();
 void run_philosophers_benchmark();
+void run_virtual_time_benchmark();
+void run_coroutine_philosophers_benchmark();
+
+// Трапезы в секунду при занятом ожидании 0 нс - 10 мкс вместо сна
+void run_contention_benchmark();
+
+// Политики отсрочки try_lock на столах разного размера: трапезы в
+// секунду и число повторов
+void run_backoff_benchmark();
+
+// Итог прогона независимых столов
+struct ConcurrentTablesResult {
+    long long meals = 0;
+    double wall_seconds = 0.0;
+    
+    double meals_per_second() const { return wall_seconds > 0.0 ? meals / wall_seconds : 0.0; }
+};
+
+// num_tables независимых столов как задачи общего пула (ThreadPool::shared)
+// из concurrency фоновых потоков; у каждого стола свои вилки и свои потоки
+// философов, одновременно идет не больше concurrency столов. Ограничение
+// по ядрам осмысленно для занятой нагрузки (Workload::spinning): спящий
+// стол держит поток пула, не загружая ядро
+ConcurrentTablesResult run_concurrent_tables(int num_tables, int philosophers_per_table,
+                                             DiningPhilosophers::Strategy strategy,
+                                             int iterations, int concurrency,
+                                             const DiningPhilosophers::Workload& workload =
+                                                 DiningPhilosophers::Workload::sleeping());
+void run_concurrent_tables_benchmark();
 
 } // namespace task3
 
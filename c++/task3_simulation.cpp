@@ -0,0 +1,369 @@
+#include "task3_simulation.h"
+#include "benchmark_utils.h"
+#include "task3_chandy_misra.h"
+#include <iostream>
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <queue>
+#include <random>
+
+namespace task3 {
+
+namespace {
+
+using Strategy = DiningPhilosophers::Strategy;
+
+enum class EventKind : uint8_t {
+    HUNGRY,      // размышление закончилось
+    RETRY,       // повторная попытка try_lock или запроса к арбитру
+    DONE_EATING, // еда закончилась
+    MESSAGE,     // сообщение Чанди-Мисры (доставляется без задержки)
+    WAKE         // битовая маска: разбуженный повторяет CAS
+};
+
+struct Event {
+    int64_t time;    // мкс виртуального времени
+    uint64_t seq;    // порядок постановки при равном времени
+    int philosopher;
+    EventKind kind;
+    ChandyMisraMessage message;
+
+    bool operator>(const Event& other) const {
+        return time != other.time ? time > other.time : seq > other.seq;
+    }
+};
+
+class VirtualTimeEngine {
+public:
+    VirtualTimeEngine(int n, Strategy strategy, int iterations, const BackoffPolicy& backoff,
+                      bool verbose, uint32_t seed)
+        : n_(n), strategy_(strategy), iterations_(iterations), backoff_(backoff), verbose_(verbose),
+          owner_(n, -1), waiters_(n), word_waiters_((n + 63) / 64), philosophers_(n) {
+        for (int id = 0; id < n_; ++id) {
+            Philosopher& p = philosophers_[id];
+            p.gen.seed(seed + id);
+            p.chandy_misra = ChandyMisraPhilosopher(id, n_);
+
+            int left = id;
+            int right = (id + 1) % n_;
+            // Порядок захвата совпадает с потоковыми реализациями
+            switch (strategy_) {
+                case Strategy::MUTEX:
+                    p.order[0] = id % 2 == 0 ? left : right;
+                    p.order[1] = id % 2 == 0 ? right : left;
+                    break;
+                case Strategy::RESOURCE_HIERARCHY:
+                    p.order[0] = std::min(left, right);
+                    p.order[1] = std::max(left, right);
+                    break;
+                default:
+                    p.order[0] = left;
+                    p.order[1] = right;
+            }
+        }
+    }
+
+    VirtualTimeStats run() {
+        Benchmark wall("Виртуальное время", false);
+        VirtualTimeStats stats;
+
+        for (int id = 0; id < n_; ++id) {
+            start_thinking(id);
+        }
+
+        while (!events_.empty()) {
+            Event e = events_.top();
+            events_.pop();
+            now_ = e.time;
+            stats.events++;
+
+            switch (e.kind) {
+                case EventKind::HUNGRY: on_hungry(e.philosopher); break;
+                case EventKind::RETRY: try_both(e.philosopher); break;
+                case EventKind::DONE_EATING: on_done_eating(e.philosopher); break;
+                case EventKind::MESSAGE: on_message(e.philosopher, e.message); break;
+                case EventKind::WAKE: try_bitmask(e.philosopher); break;
+            }
+        }
+
+        stats.wall_seconds = wall.elapsed_seconds();
+        stats.simulated_seconds = last_meal_end_ / 1e6;
+        stats.meals = meals_;
+        stats.wakeups = wakeups_;
+        stats.average_wait_ms = meals_ > 0 ? total_wait_ / 1000.0 / meals_ : 0.0;
+        stats.max_wait_ms = max_wait_ / 1000.0;
+        for (const auto& p : philosophers_) {
+            stats.meals_per_philosopher.push_back(p.meals);
+        }
+        stats.deadlock = meals_ < static_cast<long long>(n_) * iterations_;
+        return stats;
+    }
+
+private:
+    struct Philosopher {
+        std::mt19937 gen;
+        int order[2] = {0, 0};   // вилки в порядке захвата
+        int acquired = 0;        // сколько вилок из order уже взято
+        int meals = 0;
+        int64_t hungry_since = 0;
+        uint64_t ticket = 0;     // очередь официанта, 0 - не ждет
+        ChandyMisraPhilosopher chandy_misra;
+        std::optional<Backoff> backoff;   // try_lock: новое на каждое "проголодался"
+    };
+
+    int64_t think_time(Philosopher& p) { return think_dist_(p.gen) * 1000LL; }
+    int64_t eat_time(Philosopher& p) { return eat_dist_(p.gen) * 1000LL; }
+
+    int64_t retry_time(Philosopher& p) {
+        // Арбитр отвечает отказом и философ ждет 10 мс
+        if (strategy_ == Strategy::ARBITRATOR) return 10000LL;
+        Backoff::Delay delay = p.backoff->next(p.gen);
+        return std::chrono::duration_cast<std::chrono::microseconds>(delay.duration).count();
+    }
+
+    void schedule(int64_t delay, int id, EventKind kind, ChandyMisraMessage message = {}) {
+        events_.push(Event{now_ + delay, next_seq_++, id, kind, message});
+    }
+
+    // Отправка соседу: сторона получателя противоположна стороне отправителя
+    auto sender(int id) {
+        return [this, id](int side, ChandyMisraMessage::Kind kind) {
+            int to = side == ChandyMisraPhilosopher::kLeft ? (id + n_ - 1) % n_ : (id + 1) % n_;
+            schedule(0, to, EventKind::MESSAGE,
+                     ChandyMisraMessage{kind, static_cast<uint8_t>(1 - side)});
+        };
+    }
+
+    void on_message(int id, ChandyMisraMessage message) {
+        ChandyMisraPhilosopher& self = philosophers_[id].chandy_misra;
+        if (message.kind == ChandyMisraMessage::REQUEST) {
+            self.on_request(message.side, sender(id));
+        } else {
+            self.on_fork(message.side);
+        }
+        try_chandy_misra(id);
+    }
+
+    void try_chandy_misra(int id) {
+        ChandyMisraPhilosopher& self = philosophers_[id].chandy_misra;
+        if (!self.can_eat()) return;
+        self.start_eating();
+        start_eating(id);
+    }
+
+    void start_thinking(int id) {
+        Philosopher& p = philosophers_[id];
+        if (p.meals == iterations_) return;
+        schedule(think_time(p), id, EventKind::HUNGRY);
+    }
+
+    void on_hungry(int id) {
+        Philosopher& p = philosophers_[id];
+        p.hungry_since = now_;
+        if (verbose_ && p.meals < 10) {
+            std::cout << "[" << now_ / 1000 << " мс] Философ " << id
+                      << " размышляет (итерация " << p.meals + 1 << ")\n";
+        }
+
+        if (strategy_ == Strategy::TRY_LOCK || strategy_ == Strategy::ARBITRATOR) {
+            p.backoff.emplace(backoff_);
+            try_both(id);
+        } else if (strategy_ == Strategy::CHANDY_MISRA) {
+            p.chandy_misra.become_hungry(sender(id));
+            try_chandy_misra(id);
+        } else if (strategy_ == Strategy::ATOMIC_BITMASK) {
+            try_bitmask(id);
+        } else if (strategy_ == Strategy::WAITER) {
+            // Занятые вилки - в очередь официанта без повторных событий
+            if (owner_[p.order[0]] == -1 && owner_[p.order[1]] == -1) {
+                owner_[p.order[0]] = id;
+                owner_[p.order[1]] = id;
+                start_eating(id);
+            } else {
+                p.ticket = ++next_ticket_;
+            }
+        } else {
+            p.acquired = 0;
+            request_next(id);
+        }
+    }
+
+    // Блокирующий захват: свободная вилка берется сразу, занятая ставит
+    // философа в очередь ожидания этой вилки
+    void request_next(int id) {
+        Philosopher& p = philosophers_[id];
+        while (p.acquired < 2) {
+            int fork = p.order[p.acquired];
+            if (owner_[fork] != -1) {
+                waiters_[fork].push_back(id);
+                return;
+            }
+            owner_[fork] = id;
+            p.acquired++;
+        }
+        start_eating(id);
+    }
+
+    // try_lock и арбитр: обе вилки сразу или повтор через паузу
+    void try_both(int id) {
+        Philosopher& p = philosophers_[id];
+        int left = p.order[0], right = p.order[1];
+        if (owner_[left] == -1 && owner_[right] == -1) {
+            owner_[left] = id;
+            owner_[right] = id;
+            start_eating(id);
+        } else {
+            schedule(retry_time(p), id, EventKind::RETRY);
+        }
+    }
+
+    void start_eating(int id) {
+        Philosopher& p = philosophers_[id];
+        int64_t wait = now_ - p.hungry_since;
+        total_wait_ += wait;
+        max_wait_ = std::max(max_wait_, wait);
+
+        if (verbose_ && p.meals < 10) {
+            std::cout << "[" << now_ / 1000 << " мс] Философ " << id
+                      << " ест спагетти (итерация " << p.meals + 1 << ")\n";
+        }
+        schedule(eat_time(p), id, EventKind::DONE_EATING);
+    }
+
+    void on_done_eating(int id) {
+        Philosopher& p = philosophers_[id];
+        p.meals++;
+        meals_++;
+        last_meal_end_ = now_;
+
+        // Иерархия освобождает вилки в обратном порядке, остальные - левую первой
+        if (strategy_ == Strategy::CHANDY_MISRA) {
+            p.chandy_misra.finish_eating(sender(id));
+            if (p.meals == iterations_) p.chandy_misra.leave(sender(id));
+        } else if (strategy_ == Strategy::RESOURCE_HIERARCHY) {
+            release(p.order[1]);
+            release(p.order[0]);
+        } else {
+            release(id);
+            release((id + 1) % n_);
+        }
+        if (strategy_ == Strategy::WAITER) {
+            hand_over_to_neighbors(id);
+        } else if (strategy_ == Strategy::ATOMIC_BITMASK) {
+            wake_word(id / 64);
+            if ((id + 1) % n_ / 64 != id / 64) wake_word((id + 1) % n_ / 64);
+        }
+        start_thinking(id);
+    }
+
+    // Битовая маска: обе вилки сразу, иначе ожидание изменения слова
+    // с занятой вилкой; изменение будит всех ждущих на слове
+    void try_bitmask(int id) {
+        Philosopher& p = philosophers_[id];
+        int left = p.order[0], right = p.order[1];
+        if (owner_[left] == -1 && owner_[right] == -1) {
+            owner_[left] = id;
+            owner_[right] = id;
+            start_eating(id);
+        } else {
+            int busy = owner_[left] != -1 ? left : right;
+            word_waiters_[busy / 64].push_back(id);
+        }
+    }
+
+    // notify_all: проснуться должны все, а кто первым повторит CAS,
+    // решает планировщик - у каждого своя задержка
+    void wake_word(int word) {
+        std::vector<int> woken;
+        woken.swap(word_waiters_[word]);
+        for (int id : woken) {
+            wakeups_++;
+            schedule(wake_dist_(philosophers_[id].gen), id, EventKind::WAKE);
+        }
+    }
+
+    // Официант: освободились вилки двух соседей, первым получает тот,
+    // кто дольше ждет
+    void hand_over_to_neighbors(int id) {
+        int first = (id + n_ - 1) % n_;
+        int second = (id + 1) % n_;
+        uint64_t first_ticket = philosophers_[first].ticket;
+        uint64_t second_ticket = philosophers_[second].ticket;
+        if (second_ticket != 0 && (first_ticket == 0 || second_ticket < first_ticket)) {
+            std::swap(first, second);
+        }
+        hand_over(first);
+        if (second != first) hand_over(second);
+    }
+
+    void hand_over(int id) {
+        Philosopher& p = philosophers_[id];
+        if (p.ticket == 0 || owner_[p.order[0]] != -1 || owner_[p.order[1]] != -1) return;
+        owner_[p.order[0]] = id;
+        owner_[p.order[1]] = id;
+        p.ticket = 0;
+        wakeups_++;
+        start_eating(id);
+    }
+
+    // Освобожденная вилка сразу передается первому ожидающему
+    void release(int fork) {
+        owner_[fork] = -1;
+        if (waiters_[fork].empty()) return;
+
+        int next = waiters_[fork].front();
+        waiters_[fork].pop_front();
+        owner_[fork] = next;
+        philosophers_[next].acquired++;
+        wakeups_++;
+        request_next(next);
+    }
+
+    int n_;
+    Strategy strategy_;
+    int iterations_;
+    BackoffPolicy backoff_;
+    bool verbose_;
+
+    std::vector<int> owner_;                 // -1 - вилка свободна
+    std::vector<std::deque<int>> waiters_;
+    std::vector<std::vector<int>> word_waiters_;
+    std::vector<Philosopher> philosophers_;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+
+    std::uniform_int_distribution<> think_dist_{50, 200};
+    std::uniform_int_distribution<> eat_dist_{100, 300};
+    std::uniform_int_distribution<> wake_dist_{5, 50};   // мкс
+
+    int64_t now_ = 0;
+    uint64_t next_seq_ = 0;
+    uint64_t next_ticket_ = 0;
+    int64_t last_meal_end_ = 0;
+    long long meals_ = 0;
+    long long wakeups_ = 0;
+    int64_t total_wait_ = 0;
+    int64_t max_wait_ = 0;
+};
+
+} // namespace
+
+double VirtualTimeStats::meals_per_simulated_second() const {
+    return simulated_seconds > 0.0 ? meals / simulated_seconds : 0.0;
+}
+
+double VirtualTimeStats::meals_per_wall_second() const {
+    return wall_seconds > 0.0 ? meals / wall_seconds : 0.0;
+}
+
+VirtualTimeStats simulate_virtual_time(int num_philosophers,
+                                       DiningPhilosophers::Strategy strategy,
+                                       int iterations,
+                                       const BackoffPolicy& backoff,
+                                       bool verbose,
+                                       uint32_t seed) {
+    VirtualTimeEngine engine(std::max(2, num_philosophers), strategy, iterations, backoff, verbose, seed);
+    return engine.run();
+}
+
+} // namespace task3
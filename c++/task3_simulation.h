@@ -0,0 +1,49 @@
+#ifndef TASK3_SIMULATION_H
+#define TASK3_SIMULATION_H
+
+#include "task3_philosophers.h"
+#include <cstdint>
+#include <vector>
+
+namespace task3 {
+
+// Итоги симуляции в виртуальном времени
+struct VirtualTimeStats {
+    long long meals = 0;
+    long long events = 0;
+    long long wakeups = 0;            // пробуждений ждущих: передача вилки или изменение слова
+    double simulated_seconds = 0.0;   // виртуальное время до последней трапезы
+    double wall_seconds = 0.0;        // реальное время работы движка
+    double average_wait_ms = 0.0;     // от голода до начала еды
+    double max_wait_ms = 0.0;
+    std::vector<long long> meals_per_philosopher;
+    bool deadlock = false;            // события кончились раньше трапез
+
+    double meals_per_simulated_second() const;
+    double meals_per_wall_second() const;
+    double wakeups_per_meal() const { return meals > 0 ? static_cast<double>(wakeups) / meals : 0.0; }
+};
+
+// Дискретно-событийная симуляция стратегии: те же распределения времени
+// размышления, еды и повторных попыток, что и у потоков, но часы
+// виртуальные (микросекунды), а события хранятся в очереди с приоритетом.
+// Блокирующий захват моделируется очередью ожидания у каждой вилки,
+// try_lock и арбитр - повторными событиями через время паузы (у try_lock
+// паузы задает backoff, вращение - сдвиг часов на его длительность), официант -
+// очередью, из которой соседи получают вилки при их освобождении,
+// Чанди-Мисра - сообщениями, доставляемыми событиями с нулевой задержкой.
+// Битовая маска отличается от официанта тем, что вилки не передаются:
+// освобождение будит всех ждущих на слове, каждый повторяет CAS через
+// случайную задержку пробуждения (5-50 мкс), первым успевает случайный,
+// а свободные тем временем вилки может перехватить только что
+// проголодавшийся.
+VirtualTimeStats simulate_virtual_time(int num_philosophers,
+                                       DiningPhilosophers::Strategy strategy,
+                                       int iterations,
+                                       const BackoffPolicy& backoff = BackoffPolicy(),
+                                       bool verbose = false,
+                                       uint32_t seed = 26);
+
+} // namespace task3
+
+#endif // TASK3_SIMULATION_H
@@ -0,0 +1,183 @@
+#include "thread_pool.h"
+#include <map>
+
+namespace {
+
+// Пул и номер слота, к которым привязан текущий поток
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local int tls_slot = -1;
+
+} // namespace
+
+ThreadPool::ThreadPool(int num_threads)
+    : num_workers_(num_threads < 1 ? 1 : num_threads) {
+    for (int i = 0; i < num_workers_; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    // Слот 0 принадлежит вызывающему потоку, фоновые потоки - слоты 1..n-1
+    for (int i = 1; i < num_workers_; ++i) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+
+    for (auto& t : threads_) {
+        t.join();
+    }
+
+    // Без фоновых потоков оставшиеся задачи выполняем сами
+    while (try_run_one(0)) {}
+}
+
+ThreadPool& ThreadPool::shared(int num_threads) {
+    static std::mutex registry_mutex;
+    static std::map<int, std::unique_ptr<ThreadPool>> registry;
+
+    if (num_threads < 1) num_threads = 1;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& pool = registry[num_threads];
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(num_threads);
+    }
+    return *pool;
+}
+
+void ThreadPool::submit(Task task) {
+    int slot = static_cast<int>(next_queue_.fetch_add(1, std::memory_order_relaxed) % num_workers_);
+    push(slot, std::move(task));
+}
+
+void ThreadPool::submit_local(Task task) {
+    int slot = current_slot();
+    if (slot < 0) {
+        submit(std::move(task));
+        return;
+    }
+    push(slot, std::move(task));
+}
+
+void ThreadPool::push(int slot, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(queues_[slot]->mtx);
+        queues_[slot]->tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Захват мьютекса исключает потерю пробуждения между проверкой и ожиданием
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    sleep_cv_.notify_one();
+}
+
+bool ThreadPool::try_run_one(int slot) {
+    Task task;
+
+    // Сначала своя очередь (с конца - данные еще в кэше)
+    {
+        std::lock_guard<std::mutex> lock(queues_[slot]->mtx);
+        auto& own = queues_[slot]->tasks;
+        if (!own.empty()) {
+            task = std::move(own.back());
+            own.pop_back();
+        }
+    }
+
+    // Затем перехват у остальных (с начала - самые крупные и старые куски)
+    for (int i = 1; !task && i < num_workers_; ++i) {
+        int victim = (slot + i) % num_workers_;
+        std::lock_guard<std::mutex> lock(queues_[victim]->mtx);
+        auto& other = queues_[victim]->tasks;
+        if (!other.empty()) {
+            task = std::move(other.front());
+            other.pop_front();
+        }
+    }
+
+    if (!task) return false;
+
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+void ThreadPool::worker_loop(int slot) {
+    tls_pool = this;
+    tls_slot = slot;
+
+    while (true) {
+        if (try_run_one(slot)) continue;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this]() {
+            return stop_ || queued_.load(std::memory_order_acquire) > 0;
+        });
+
+        if (stop_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+int ThreadPool::current_slot() const {
+    return tls_pool == this ? tls_slot : -1;
+}
+
+size_t ThreadPool::auto_grain(size_t count, size_t grain) const {
+    if (grain > 0) return grain;
+
+    size_t chunks = static_cast<size_t>(num_workers_) * kChunksPerWorker;
+    size_t step = (count + chunks - 1) / chunks;
+    return step < 1024 ? 1024 : step;
+}
+
+void ThreadPool::run_chunks(size_t begin, size_t end, size_t grain,
+                            const std::function<void(size_t, size_t, size_t)>& chunk) {
+    int slot = current_slot();
+
+    // Внешний поток временно становится исполнителем 0 этого пула
+    std::unique_lock<std::mutex> external_lock(external_mutex_, std::defer_lock);
+    const ThreadPool* saved_pool = tls_pool;
+    int saved_slot = tls_slot;
+    if (slot < 0) {
+        external_lock.lock();
+        slot = 0;
+        tls_pool = this;
+        tls_slot = 0;
+    }
+
+    size_t num_chunks = (end - begin + grain - 1) / grain;
+    std::atomic<size_t> remaining{num_chunks};
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[slot]->mtx);
+        // Кладем в обратном порядке, чтобы владелец начал с первого куска
+        for (size_t i = num_chunks; i-- > 0;) {
+            queues_[slot]->tasks.push_back([&, i]() {
+                size_t b = begin + i * grain;
+                size_t e = b + grain < end ? b + grain : end;
+                chunk(static_cast<size_t>(tls_slot), b, e);
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+    }
+    queued_.fetch_add(num_chunks, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    sleep_cv_.notify_all();
+
+    // Помогаем выполнять задачи, пока не завершатся все куски
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!try_run_one(slot)) {
+            std::this_thread::yield();
+        }
+    }
+
+    tls_pool = saved_pool;
+    tls_slot = saved_slot;
+}
@@ -0,0 +1,142 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Размер кэш-линии для выравнивания данных, изменяемых разными потоками
+constexpr size_t kCacheLineSize = 64;
+
+// Ячейка аккумулятора исполнителя. Выровненный вариант занимает отдельную
+// кэш-линию, невыровненный оставлен для сравнения (ложное разделение).
+template <typename T, bool Padded>
+struct ReductionSlot {
+    T value;
+};
+
+template <typename T>
+struct alignas(kCacheLineSize) ReductionSlot<T, true> {
+    T value;
+};
+
+// Постоянный пул потоков с перехватом задач (work stealing).
+// Каждый исполнитель имеет собственную очередь: свои задачи берет с конца,
+// чужие перехватывает с начала. Поток, вызвавший parallel_for, сам
+// участвует в работе как исполнитель с номером 0.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // Диапазоны короче этого порога выполняются в вызывающем потоке без
+    // обращения к пулу: накладные расходы на задачи больше выигрыша.
+    static constexpr size_t kSequentialCutoff = 8192;
+
+    // Число кусков на одного исполнителя при автоматическом выборе зерна
+    static constexpr size_t kChunksPerWorker = 8;
+
+    // num_threads - общее число исполнителей, включая вызывающий поток
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return num_workers_; }
+
+    // Общий пул для заданного числа потоков (создается при первом обращении)
+    static ThreadPool& shared(int num_threads);
+
+    // Поставить задачу в очередь без ожидания результата
+    void submit(Task task);
+
+    // Из потока этого пула - в его собственную очередь (продолжение остается
+    // в кэше исполнителя), из внешнего потока - как submit
+    void submit_local(Task task);
+
+    // Вызывает body(chunk_begin, chunk_end) для кусков [begin, end).
+    // grain == 0 - размер куска выбирается автоматически.
+    template <typename Body>
+    void parallel_for(size_t begin, size_t end, Body&& body, size_t grain = 0);
+
+    // Параллельная свертка. Accumulator должен конструироваться по умолчанию
+    // (нейтральный элемент) и иметь merge(const Accumulator&). fold(b, e, acc)
+    // накапливает кусок [b, e) прямо в аккумулятор исполнителя; в конце
+    // аккумуляторы объединяются попарно деревом.
+    template <typename Accumulator, bool Padded = true, typename Fold>
+    Accumulator parallel_reduce(size_t begin, size_t end, Fold&& fold, size_t grain = 0);
+
+private:
+    struct WorkerQueue {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    int num_workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> next_queue_{0};
+    bool stop_ = false;
+
+    // Внешние потоки занимают слот 0 по очереди
+    std::mutex external_mutex_;
+
+    void push(int slot, Task task);
+    bool try_run_one(int slot);
+    void worker_loop(int slot);
+    int current_slot() const;
+
+    size_t auto_grain(size_t count, size_t grain) const;
+    // chunk(slot, b, e) вызывается исполнителем с номером slot
+    void run_chunks(size_t begin, size_t end, size_t grain,
+                    const std::function<void(size_t, size_t, size_t)>& chunk);
+};
+
+template <typename Body>
+void ThreadPool::parallel_for(size_t begin, size_t end, Body&& body, size_t grain) {
+    if (end <= begin) return;
+
+    if (end - begin < kSequentialCutoff || num_workers_ == 1) {
+        body(begin, end);
+        return;
+    }
+
+    run_chunks(begin, end, auto_grain(end - begin, grain),
+               [&body](size_t, size_t b, size_t e) { body(b, e); });
+}
+
+template <typename Accumulator, bool Padded, typename Fold>
+Accumulator ThreadPool::parallel_reduce(size_t begin, size_t end, Fold&& fold, size_t grain) {
+    Accumulator result{};
+    if (end <= begin) return result;
+
+    if (end - begin < kSequentialCutoff || num_workers_ == 1) {
+        fold(begin, end, result);
+        return result;
+    }
+
+    std::vector<ReductionSlot<Accumulator, Padded>> slots(num_workers_);
+
+    run_chunks(begin, end, auto_grain(end - begin, grain),
+               [&](size_t slot, size_t b, size_t e) { fold(b, e, slots[slot].value); });
+
+    // Древовидное объединение: на каждом уровне сливаем пары с шагом stride
+    for (size_t stride = 1; stride < slots.size(); stride *= 2) {
+        for (size_t i = 0; i + stride < slots.size(); i += 2 * stride) {
+            slots[i].value.merge(slots[i + stride].value);
+        }
+    }
+    return slots[0].value;
+}
+
+#endif // THREAD_POOL_H